@@ -0,0 +1,92 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#pragma once
+
+#include <Mahi/Util/Types.hpp>
+#include <cstdio>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+// Minimal benchmark harness for mahi::util.
+//
+// A benchmark is a function which performs n operations. The harness warms
+// it up, picks n so that one repetition lasts at least --min-time, then
+// times --reps repetitions and reports the median and median absolute
+// deviation (MAD) per operation, in nanoseconds and (on x86) TSC cycles.
+// Results can be saved as JSON and compared against a previous run:
+//
+//     bench --json base.json            # on the old commit
+//     bench --compare base.json         # on the new commit
+
+namespace bench {
+
+using mahi::util::uint64;
+
+/// A benchmark body which must perform n operations
+typedef std::function<void(uint64 n)> BenchFunc;
+
+/// Registers a benchmark at static initialization (use BENCHMARK instead)
+struct Registrar {
+    Registrar(const char* name, BenchFunc func);
+};
+
+/// Returns all registered benchmarks
+std::vector<std::pair<std::string, BenchFunc>>& registry();
+
+/// Prevents the compiler from optimizing away the computation of value
+template <typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+}
+
+/// Prevents the compiler from assuming memory is unchanged
+inline void clobber_memory() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+/// Removes files when destroyed. Declare one static before the static state
+/// which writes the files, so that they are removed at exit after that state
+/// has been destroyed (and has closed them).
+struct RemoveAtExit {
+    RemoveAtExit(std::initializer_list<const char*> paths) : files(paths.begin(), paths.end()) {}
+    ~RemoveAtExit() {
+        for (auto& f : files)
+            std::remove(f.c_str());
+    }
+    std::vector<std::string> files;
+};
+
+} // namespace bench
+
+#define BENCH_CAT_(a, b) a##b
+#define BENCH_CAT(a, b) BENCH_CAT_(a, b)
+
+/// Defines and registers a benchmark. The body receives uint64 n, the number
+/// of operations to perform.
+#define BENCHMARK(name)                                                            \
+    static void BENCH_CAT(bench_, name)(bench::uint64 n);                          \
+    static bench::Registrar BENCH_CAT(bench_registrar_, name)(#name, BENCH_CAT(bench_, name)); \
+    static void BENCH_CAT(bench_, name)(bench::uint64 n)
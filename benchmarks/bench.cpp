@@ -0,0 +1,219 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#include "Bench.hpp"
+#include <Mahi/Util/Console.hpp>
+#include <Mahi/Util/Print.hpp>
+#include <Mahi/Util/System.hpp>
+#include <Mahi/Util/Timing/Clock.hpp>
+#include <Mahi/Util/Timing/Timestamp.hpp>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define BENCH_HAS_TSC
+#endif
+
+using namespace mahi::util;
+using nlohmann::json;
+
+namespace bench {
+
+std::vector<std::pair<std::string, BenchFunc>>& registry() {
+    static std::vector<std::pair<std::string, BenchFunc>> benchmarks;
+    return benchmarks;
+}
+
+Registrar::Registrar(const char* name, BenchFunc func) {
+    registry().emplace_back(name, func);
+}
+
+} // namespace bench
+
+namespace {
+
+/// Reads the TSC, or 0 if unavailable
+inline uint64 cycles() {
+#ifdef BENCH_HAS_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+double median(std::vector<double> v) {
+    std::sort(v.begin(), v.end());
+    const std::size_t m = v.size() / 2;
+    return v.size() % 2 ? v[m] : 0.5 * (v[m - 1] + v[m]);
+}
+
+double mad(const std::vector<double>& v, double med) {
+    std::vector<double> dev(v.size());
+    for (std::size_t i = 0; i < v.size(); ++i)
+        dev[i] = std::abs(v[i] - med);
+    return median(dev);
+}
+
+/// Results of one benchmark
+struct Result {
+    std::string name;
+    uint64 iterations;
+    std::vector<double> ns;      ///< ns/op of each repetition
+    std::vector<double> cycles;  ///< cycles/op of each repetition
+    double median_ns, mad_ns, min_ns, max_ns, median_cycles;
+};
+
+/// Times one call of func(n), returning [ns, cycles]
+std::pair<double, double> time_once(const bench::BenchFunc& func, uint64 n) {
+    const uint64 c0 = cycles();
+    const int64 t0  = Clock::get_current_time().as_nanoseconds();
+    func(n);
+    const int64 t1  = Clock::get_current_time().as_nanoseconds();
+    const uint64 c1 = cycles();
+    return std::make_pair(static_cast<double>(t1 - t0), static_cast<double>(c1 - c0));
+}
+
+Result run(const std::string& name, const bench::BenchFunc& func, int reps, double min_time_ns, double warmup_ns) {
+    // warm up caches, branch predictors and the CPU clock, and grow n until a
+    // repetition takes at least min_time
+    uint64 n = 1;
+    double elapsed = 0;
+    const int64 start = Clock::get_current_time().as_nanoseconds();
+    while (true) {
+        elapsed = time_once(func, n).first;
+        const bool warm = Clock::get_current_time().as_nanoseconds() - start >= warmup_ns;
+        if (elapsed >= min_time_ns && warm)
+            break;
+        if (elapsed < min_time_ns) {
+            const double scale = elapsed > 0 ? 1.4 * min_time_ns / elapsed : 10.0;
+            n = static_cast<uint64>(n * (std::min)(10.0, (std::max)(2.0, scale)));
+        }
+    }
+    Result r;
+    r.name = name;
+    r.iterations = n;
+    for (int i = 0; i < reps; ++i) {
+        auto t = time_once(func, n);
+        r.ns.push_back(t.first / n);
+        r.cycles.push_back(t.second / n);
+    }
+    r.median_ns     = median(r.ns);
+    r.mad_ns        = mad(r.ns, r.median_ns);
+    r.min_ns        = *std::min_element(r.ns.begin(), r.ns.end());
+    r.max_ns        = *std::max_element(r.ns.begin(), r.ns.end());
+    r.median_cycles = median(r.cycles);
+    return r;
+}
+
+json to_json(const Result& r) {
+    json j = {{"name", r.name}, {"iterations", r.iterations}, {"repetitions", r.ns.size()},
+              {"median_ns", r.median_ns}, {"mad_ns", r.mad_ns}, {"min_ns", r.min_ns},
+              {"max_ns", r.max_ns}, {"samples_ns", r.ns}};
+#ifdef BENCH_HAS_TSC
+    j["median_cycles"] = r.median_cycles;
+#endif
+    return j;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options("bench", "Benchmarks mahi::util hot paths");
+    options.add_options()
+        ("f,filter",  "Only run benchmarks whose name contains this string", value<std::string>()->default_value(""))
+        ("r,reps",    "Repetitions per benchmark", value<int>()->default_value("15"))
+        ("t,min-time","Minimum duration of one repetition [ms]", value<double>()->default_value("20"))
+        ("w,warmup",  "Minimum warmup duration [ms]", value<double>()->default_value("100"))
+        ("j,json",    "Save results to this JSON file", value<std::string>()->default_value(""))
+        ("c,compare", "Compare results against this JSON file", value<std::string>()->default_value(""))
+        ("l,label",   "Label stored in the JSON (e.g. a commit hash)", value<std::string>()->default_value(""))
+        ("list",      "List benchmarks and exit")
+        ("h,help",    "Print help");
+    auto args = options.parse(argc, argv);
+    if (args.count("help")) {
+        print("{}", options.help());
+        return 0;
+    }
+    if (args.count("list")) {
+        for (auto& b : bench::registry())
+            print("{}", b.first);
+        return 0;
+    }
+
+    const std::string filter = args["filter"].as<std::string>();
+    const int reps           = (std::max)(1, args["reps"].as<int>());
+    const double min_time_ns = args["min-time"].as<double>() * 1e6;
+    const double warmup_ns   = args["warmup"].as<double>() * 1e6;
+
+    // baseline medians to compare against
+    std::map<std::string, std::pair<double, double>> baseline;
+    const std::string compare = args["compare"].as<std::string>();
+    if (!compare.empty()) {
+        std::ifstream file(compare);
+        if (!file.is_open()) {
+            print("Could not open {}", compare);
+            return 1;
+        }
+        json j = json::parse(file);
+        for (auto& b : j["benchmarks"])
+            baseline[b["name"].get<std::string>()] = std::make_pair(b["median_ns"].get<double>(), b["mad_ns"].get<double>());
+    }
+
+    print("{:<32} {:>12} {:>12} {:>10} {:>12} {:>10}{}", "Benchmark", "Iterations", "Median [ns]", "MAD [ns]",
+          "Min [ns]", "Cycles", baseline.empty() ? "" : "     Change");
+    json results = json::array();
+    for (auto& b : bench::registry()) {
+        if (b.first.find(filter) == std::string::npos)
+            continue;
+        Result r = run(b.first, b.second, reps, min_time_ns, warmup_ns);
+        std::string line = fmt::format("{:<32} {:>12} {:>12.2f} {:>10.2f} {:>12.2f} {:>10.1f}", r.name, r.iterations,
+                                       r.median_ns, r.mad_ns, r.min_ns, r.median_cycles);
+        auto base = baseline.find(r.name);
+        if (base != baseline.end() && base->second.first > 0) {
+            // a change is significant if it exceeds 3 MADs of either run
+            const double change = 100.0 * (r.median_ns - base->second.first) / base->second.first;
+            const bool significant = std::abs(r.median_ns - base->second.first) > 3 * (std::max)(r.mad_ns, base->second.second);
+            line += fmt::format(" {:>+9.1f}%{}", change, significant ? (change > 0 ? " slower" : " faster") : "");
+        }
+        print("{}", line);
+        results.push_back(to_json(r));
+    }
+
+    const std::string json_path = args["json"].as<std::string>();
+    if (!json_path.empty()) {
+        json context = {{"date", Timestamp().yyyy_mm_dd_hh_mm_ss()}, {"label", args["label"].as<std::string>()},
+                        {"os", os_name()}, {"os_version", os_version()},
+                        {"hardware_threads", std::thread::hardware_concurrency()},
+                        {"tsc_clock", Clock::is_tsc()}, {"repetitions", reps},
+                        {"min_time_ms", min_time_ns / 1e6}};
+        std::ofstream file(json_path);
+        file << json({{"context", context}, {"benchmarks", results}}).dump(2);
+        if (!file.good()) {
+            print("Could not write {}", json_path);
+            return 1;
+        }
+    }
+    return 0;
+}
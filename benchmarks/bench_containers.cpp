@@ -0,0 +1,65 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#include "Bench.hpp"
+#include <Mahi/Util/Templates/RingBuffer.hpp>
+#include <Mahi/Util/Templates/SPSCQueue.hpp>
+#include <thread>
+
+using namespace mahi::util;
+
+BENCHMARK(spsc_push_pop) {
+    SPSCQueue<double> queue(1024);
+    for (uint64 i = 0; i < n; ++i) {
+        queue.try_push(static_cast<double>(i));
+        bench::do_not_optimize(*queue.front());
+        queue.pop();
+    }
+}
+
+// one op is one element handed from a producer thread to the calling thread
+BENCHMARK(spsc_two_threads) {
+    SPSCQueue<uint64> queue(4096);
+    std::thread producer([&]() {
+        for (uint64 i = 0; i < n; ++i)
+            queue.push(i);
+    });
+    for (uint64 i = 0; i < n; ++i) {
+        uint64* v;
+        while (!(v = queue.front()))
+            ;
+        bench::do_not_optimize(*v);
+        queue.pop();
+    }
+    producer.join();
+}
+
+BENCHMARK(ring_buffer_push_back) {
+    RingBuffer<double> buffer(1000);
+    for (uint64 i = 0; i < n; ++i)
+        buffer.push_back(static_cast<double>(i));
+    bench::do_not_optimize(buffer[0]);
+}
+
+BENCHMARK(ring_buffer_index) {
+    RingBuffer<double> buffer(1000);
+    for (std::size_t i = 0; i < 1500; ++i)
+        buffer.push_back(static_cast<double>(i));
+    double sum = 0;
+    for (uint64 i = 0; i < n; ++i)
+        sum += buffer[i % 1000];
+    bench::do_not_optimize(sum);
+}
@@ -0,0 +1,54 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#include "Bench.hpp"
+#include <Mahi/Util/Logging/Csv.hpp>
+#include <array>
+#include <cstdio>
+#include <vector>
+
+using namespace mahi::util;
+
+// one op is one row of 8 doubles
+BENCHMARK(csv_write_row) {
+    Csv csv("bench_write.csv");
+    for (uint64 i = 0; i < n; ++i) {
+        const double x = static_cast<double>(i);
+        csv.write_row(x, x * 0.5, x * 0.25, x * 0.125, -x, 1.0 / (x + 1), x * x, 3.14159);
+    }
+    csv.close();
+    std::remove("bench_write.csv");
+}
+
+// one op is reading back a file of 10000 rows of 8 doubles
+BENCHMARK(csv_read_rows_10k) {
+    static const std::size_t rows = 10000;
+    static bench::RemoveAtExit files({"bench_read.csv"});
+    static bool written = false;
+    if (!written) {
+        std::vector<std::array<double, 8>> data(rows);
+        for (std::size_t r = 0; r < rows; ++r)
+            for (std::size_t c = 0; c < 8; ++c)
+                data[r][c] = r * 0.001 + c;
+        csv_write_rows("bench_read.csv", data);
+        written = true;
+    }
+    std::vector<std::array<double, 8>> data(rows);
+    for (uint64 i = 0; i < n; ++i) {
+        csv_read_rows("bench_read.csv", data);
+        bench::do_not_optimize(data[0][0]);
+    }
+}
@@ -0,0 +1,158 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#include "Bench.hpp"
+#include <Mahi/Util/Math/Butterworth.hpp>
+#include <Mahi/Util/Math/FilterBank.hpp>
+#include <Mahi/Util/Math/FixedFilter.hpp>
+#include <Mahi/Util/Math/Signal.hpp>
+#include <algorithm>
+#include <vector>
+
+using namespace mahi::util;
+
+namespace {
+
+    void filter_update(std::size_t order, uint64 n) {
+        Butterworth filter(order, 0.05);
+        double y = 0;
+        for (uint64 i = 0; i < n; ++i)
+            y = filter.update(static_cast<double>(i & 255) + y * 1e-9);
+        bench::do_not_optimize(y);
+    }
+
+} // namespace
+
+BENCHMARK(butterworth2_update) { filter_update(2, n); }
+BENCHMARK(butterworth4_update) { filter_update(4, n); }
+BENCHMARK(butterworth8_update) { filter_update(8, n); }
+
+namespace {
+
+    void filter_process(std::size_t order, uint64 n) {
+        Butterworth filter(order, 0.05);
+        static std::vector<double> x(4096);
+        for (std::size_t i = 0; i < x.size(); ++i)
+            x[i] = static_cast<double>(i & 255);
+        std::vector<double> y(x.size());
+        for (uint64 i = 0; i < n; i += x.size()) {
+            const std::size_t count = static_cast<std::size_t>(std::min<uint64>(x.size(), n - i));
+            filter.process(x.data(), y.data(), count);
+        }
+        bench::do_not_optimize(y[0]);
+    }
+
+} // namespace
+
+// one op is one sample
+BENCHMARK(butterworth2_process) { filter_process(2, n); }
+BENCHMARK(butterworth4_process) { filter_process(4, n); }
+BENCHMARK(butterworth8_process) { filter_process(8, n); }
+
+namespace {
+
+    const std::size_t CHANNELS = 32;
+
+    void filters_update(uint64 n) {
+        std::vector<Butterworth> filters(CHANNELS, Butterworth(2, 0.05));
+        std::vector<double> x(CHANNELS), y(CHANNELS);
+        for (uint64 i = 0; i < n; ++i) {
+            for (std::size_t c = 0; c < CHANNELS; ++c)
+                x[c] = static_cast<double>((i + c) & 255);
+            for (std::size_t c = 0; c < CHANNELS; ++c)
+                y[c] = filters[c].update(x[c]);
+            bench::clobber_memory();
+        }
+        bench::do_not_optimize(y[0]);
+    }
+
+    void filter_bank_update(uint64 n) {
+        FilterBank bank(Butterworth(2, 0.05), CHANNELS);
+        std::vector<double> x(CHANNELS), y(CHANNELS);
+        for (uint64 i = 0; i < n; ++i) {
+            for (std::size_t c = 0; c < CHANNELS; ++c)
+                x[c] = static_cast<double>((i + c) & 255);
+            bank.update(x.data(), y.data());
+            bench::clobber_memory();
+        }
+        bench::do_not_optimize(y[0]);
+    }
+
+} // namespace
+
+// one op is one tick of 32 channels
+BENCHMARK(butterworth2_32_filters) { filters_update(n); }
+BENCHMARK(butterworth2_32_filter_bank) { filter_bank_update(n); }
+
+namespace {
+
+    template <typename T>
+    void sos_process(std::size_t order, uint64 n) {
+        SosFilter<T> filter(Butterworth::design_sos(order, 0.05));
+        static std::vector<T> x(4096);
+        for (std::size_t i = 0; i < x.size(); ++i)
+            x[i] = static_cast<T>(i & 255);
+        std::vector<T> y(x.size());
+        for (uint64 i = 0; i < n; i += x.size()) {
+            const std::size_t count = static_cast<std::size_t>(std::min<uint64>(x.size(), n - i));
+            filter.process(x.data(), y.data(), count);
+        }
+        bench::do_not_optimize(y[0]);
+    }
+
+} // namespace
+
+// one op is one sample
+BENCHMARK(butterworth8_sos_double_process) { sos_process<double>(8, n); }
+BENCHMARK(butterworth8_sos_float_process) { sos_process<float>(8, n); }
+
+namespace {
+
+    template <std::size_t Order>
+    void fixed_filter_update(uint64 n) {
+        FixedFilter<Order> filter(Butterworth(Order, 0.05));
+        double y = 0;
+        for (uint64 i = 0; i < n; ++i)
+            y = filter.update(static_cast<double>(i & 255) + y * 1e-9);
+        bench::do_not_optimize(y);
+    }
+
+} // namespace
+
+BENCHMARK(butterworth2_fixed_update) { fixed_filter_update<2>(n); }
+BENCHMARK(butterworth4_fixed_update) { fixed_filter_update<4>(n); }
+BENCHMARK(butterworth8_fixed_update) { fixed_filter_update<8>(n); }
+
+namespace {
+
+    template <typename Design>
+    void filtfilt_buffer(const Design& design, uint64 n) {
+        static std::vector<double> x(1 << 16);
+        for (std::size_t i = 0; i < x.size(); ++i)
+            x[i] = static_cast<double>(i & 255);
+        std::vector<double> y(x.size());
+        for (uint64 i = 0; i < n; i += x.size()) {
+            const std::size_t count = static_cast<std::size_t>(std::min<uint64>(x.size(), n - i));
+            filtfilt(design, x.data(), y.data(), count);
+        }
+        bench::do_not_optimize(y[0]);
+    }
+
+} // namespace
+
+// one op is one sample
+BENCHMARK(butterworth4_filtfilt) { filtfilt_buffer(Butterworth(4, 0.05), n); }
+BENCHMARK(butterworth8_sos_filtfilt) { filtfilt_buffer(Butterworth::design_sos(8, 0.05), n); }
@@ -0,0 +1,80 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#include "Bench.hpp"
+#include <Mahi/Util/Logging/BinaryLog.hpp>
+#include <Mahi/Util/Logging/Log.hpp>
+#include <cstdio>
+
+using namespace mahi::util;
+
+namespace {
+
+    enum { BenchLogger = 100, BenchAsyncLogger = 101, BenchBinaryLogger = 102 };
+
+    /// Discards records after formatting them, so only the Logger is measured
+    class NullWriter : public Writer {
+    public:
+        virtual void write(const LogRecord& record) override {
+            bench::do_not_optimize(TxtFormatter::format(record));
+        }
+    };
+
+    /// Discards records without formatting them
+    class DiscardWriter : public Writer {
+    public:
+        virtual void write(const LogRecord&) override {}
+    };
+
+    NullWriter& null_writer() {
+        static NullWriter writer;
+        return writer;
+    }
+
+} // namespace
+
+BENCHMARK(log_filtered_out) {
+    static Logger<BenchLogger>& logger = init_logger<BenchLogger>(Info, &null_writer());
+    (void)logger;
+    for (uint64 i = 0; i < n; ++i)
+        LOG_(BenchLogger, Debug) << "filtered " << i;
+}
+
+BENCHMARK(log_sync_format) {
+    static Logger<BenchLogger>& logger = init_logger<BenchLogger>(Info, &null_writer());
+    (void)logger;
+    for (uint64 i = 0; i < n; ++i)
+        LOG_(BenchLogger, Info) << "value " << i << " = " << 0.5 * i;
+}
+
+// the writer discards records, so this measures handing records to the
+// background thread rather than formatting them
+BENCHMARK(log_async_enqueue) {
+    static DiscardWriter writer;
+    static Logger<BenchAsyncLogger>& logger = init_logger<BenchAsyncLogger>(Info, &writer,
+        AsyncLogOptions(65536, AsyncLogOptions::Block));
+    for (uint64 i = 0; i < n; ++i)
+        LOG_(BenchAsyncLogger, Info) << "value " << i << " = " << 0.5 * i;
+    logger.flush();
+}
+
+BENCHMARK(blog_record) {
+    static bench::RemoveAtExit files({"bench_blog.blog", "bench_blog.1.blog"});
+    static BinaryLogger<BenchBinaryLogger>& logger = init_binary_logger<BenchBinaryLogger>(Info, "bench_blog.blog", 64 * 1024 * 1024, 2);
+    for (uint64 i = 0; i < n; ++i)
+        BLOG_(BenchBinaryLogger, Info, "value {} = {}", i, 0.5 * i);
+    logger.flush();
+}
@@ -0,0 +1,53 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#include "Bench.hpp"
+#include <Mahi/Util/Timing/Clock.hpp>
+#include <Mahi/Util/Timing/Timer.hpp>
+#include <Mahi/Util/Timing/Timestamp.hpp>
+
+using namespace mahi::util;
+
+BENCHMARK(clock_get_current_time) {
+    for (uint64 i = 0; i < n; ++i)
+        bench::do_not_optimize(Clock::get_current_time());
+}
+
+BENCHMARK(timestamp_now) {
+    for (uint64 i = 0; i < n; ++i)
+        bench::do_not_optimize(Timestamp::epoch_microseconds());
+}
+
+// a 1 ns period means every wait() is already late, so this measures the
+// bookkeeping cost of a tick rather than the time spent waiting
+BENCHMARK(timer_wait_overhead) {
+    Timer timer(nanoseconds(1), Timer::WaitMode::Busy, false);
+    for (uint64 i = 0; i < n; ++i)
+        bench::do_not_optimize(timer.wait());
+}
+
+BENCHMARK(timer_wait_overhead_stats) {
+    Timer timer(nanoseconds(1), Timer::WaitMode::Busy, false);
+    timer.enable_statistics();
+    for (uint64 i = 0; i < n; ++i)
+        bench::do_not_optimize(timer.wait());
+}
+
+BENCHMARK(timer_deadline_overhead) {
+    Timer timer(nanoseconds(1), Timer::WaitMode::Deadline, false);
+    for (uint64 i = 0; i < n; ++i)
+        bench::do_not_optimize(timer.wait());
+}
@@ -0,0 +1,64 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#include <Mahi/Util.hpp>
+
+using namespace mahi::util;
+
+// Usage:
+// Run the example to compare the cost of writing rows from a control loop
+// with Csv (formatting on the calling thread) and AsyncCsv (formatting on a
+// background writer thread).
+
+int main() {
+    const int rows = 200000;
+
+    Csv csv("async_csv_example/sync.csv");
+    csv.write_row("time", "position", "velocity", "torque");
+    Time worst_csv = Time::Zero;
+    Clock total, clock;
+    for (int i = 0; i < rows; ++i) {
+        clock.restart();
+        csv.write_row(i * 0.001, std::sin(i * 0.001), std::cos(i * 0.001), i * 0.5);
+        worst_csv = std::max(worst_csv, clock.get_elapsed_time());
+    }
+    Time t_csv = total.get_elapsed_time();
+    csv.close();
+
+    AsyncCsvOptions options;
+    options.capacity = 16384; // rows
+    AsyncCsv async("async_csv_example/async.csv", {"time", "position", "velocity", "torque"}, options);
+    Time worst_async = Time::Zero;
+    total.restart();
+    for (int i = 0; i < rows; ++i) {
+        clock.restart();
+        async.write_row(i * 0.001, std::sin(i * 0.001), std::cos(i * 0.001), i * 0.5);
+        worst_async = std::max(worst_async, clock.get_elapsed_time());
+        // pace the loop a little so the writer thread can keep up
+        if (i % 1000 == 0)
+            sleep(milliseconds(1));
+    }
+    Time t_async = total.get_elapsed_time();
+    async.close();
+
+    AsyncCsvStats stats = async.get_stats();
+    print("Csv:      {:.3f} us/row, worst {}", t_csv.as_microseconds() / (double)rows, worst_csv);
+    print("AsyncCsv: {:.3f} us/row (including sleeps), worst {}", t_async.as_microseconds() / (double)rows, worst_async);
+    print("Written:  {}, dropped: {}, high water mark: {}/{}", stats.rows_written, stats.rows_dropped,
+          stats.high_water_mark, stats.capacity);
+    print("Writer:   format {}, write {}", stats.format_time, stats.write_time);
+    return 0;
+}
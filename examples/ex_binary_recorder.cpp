@@ -0,0 +1,76 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#include <Mahi/Util.hpp>
+
+using namespace mahi::util;
+
+// Usage:
+// Run the example to compare recording 1,000,000 rows of sensor data with Csv
+// and BinaryRecorder, and loading a column back for analysis.
+
+int main() {
+    const int rows = 1000000;
+
+    // Csv
+    Csv csv("binary_recorder_example/data.csv");
+    csv.write_row("time", "position", "velocity", "state");
+    Clock clock;
+    for (int i = 0; i < rows; ++i)
+        csv.write_row(i * 0.001, std::sin(i * 0.001), std::cos(i * 0.001), i % 4);
+    csv.close();
+    Time t_csv_write = clock.get_elapsed_time();
+
+    // BinaryRecorder
+    BinaryRecorder rec("binary_recorder_example/data.rec", {record_column<double>("time"),
+                                                             record_column<double>("position"),
+                                                             record_column<float>("velocity"),
+                                                             record_column<int32>("state")});
+    clock.restart();
+    for (int i = 0; i < rows; ++i)
+        rec.record(i * 0.001, std::sin(i * 0.001), std::cos(i * 0.001), i % 4);
+    rec.close();
+    Time t_rec_write = clock.get_elapsed_time();
+
+    // load the position column from each
+    clock.restart();
+    std::vector<std::vector<double>> table(rows, std::vector<double>(4));
+    csv_read_rows("binary_recorder_example/data.csv", table, 1);
+    std::vector<double> csv_position(rows);
+    for (int i = 0; i < rows; ++i)
+        csv_position[i] = table[i][1];
+    Time t_csv_read = clock.get_elapsed_time();
+
+    clock.restart();
+    BinaryRecordingReader reader("binary_recorder_example/data.rec");
+    // each chunk of a column is read in place from the mapped file (column()
+    // would instead copy the whole column into one contiguous array)
+    double sum = 0;
+    for (auto& chunk : reader.column_chunks<double>("position")) {
+        for (auto& x : chunk)
+            sum += x;
+    }
+    Time t_rec_read = clock.get_elapsed_time();
+
+    print("Rows:        {} ({} chunks)", reader.row_count(), reader.chunk_count());
+    print("Mean:        {}", sum / reader.row_count());
+    print("Csv:         write {}, read {}", t_csv_write, t_csv_read);
+    print("Recorder:    write {}, read {}", t_rec_write, t_rec_read);
+
+    // convert the recording to CSV for other tools
+    binary_recording_to_csv("binary_recorder_example/data.rec", "binary_recorder_example/converted.csv");
+    return 0;
+}
@@ -20,6 +20,8 @@
 using namespace mahi::util;
 using namespace std;
 
+enum Mode { Idle, Homing, Running };
+
 int main() {
 
     //=========================================================================
@@ -99,5 +101,27 @@ int main() {
         print("Wait Ratio: {}", timer.get_wait_ratio());        
     }
 
+    //=========================================================================
+    // Example 5: Typed rows with CsvSchema
+    //=========================================================================
+
+    // column names and types are fixed up front, so each column gets its own
+    // formatter (here, doubles are written with 4 digits after the point)
+    CsvSchema<double, int, bool, Mode> schema({"time", "count", "enabled", "mode"}, 4);
+    Csv typed("relative_folder/data4.csv");
+    typed.write_header(schema);
+    Clock clock;
+    for (int i = 0; i < 100000; ++i)
+        typed.write_row(schema, i * 0.001, i, i % 2 == 0, static_cast<Mode>(i % 3));
+    typed.close();
+    print("Wrote 100000 typed rows in {}", clock.get_elapsed_time());
+
+    // the same schema parses the rows back into tuples
+    CsvReader reader("relative_folder/data4.csv");
+    vector<decltype(schema)::Row> typed_rows;
+    reader.read_rows(schema, typed_rows);
+    print("Read {} rows, last time {} mode {}", typed_rows.size(),
+          get<0>(typed_rows.back()), static_cast<int>(get<3>(typed_rows.back())));
+
     return 0;
 }
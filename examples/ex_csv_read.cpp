@@ -0,0 +1,144 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#include <Mahi/Util.hpp>
+#include <array>
+
+using namespace mahi::util;
+
+// Usage:
+// Run the example to benchmark reading a large CSV file. The "getline" result
+// reproduces the std::getline/std::istringstream parsing csv_read_rows used
+// before CsvReader, for comparison. Pass a row count to change the file size.
+
+template <typename Container2D>
+bool getline_read_rows(const std::string& filepath, Container2D& data_out) {
+    std::ifstream file(filepath);
+    if (!file.is_open())
+        return false;
+    std::string line_string;
+    std::size_t row_w_idx = 0;
+    while (std::getline(file, line_string) && row_w_idx < data_out.size()) {
+        std::istringstream line_stream(line_string);
+        std::string value_string;
+        std::size_t col_w_idx = 0;
+        while (std::getline(line_stream, value_string, ',') && col_w_idx < data_out[row_w_idx].size()) {
+            std::istringstream value_stream(value_string);
+            value_stream >> data_out[row_w_idx][col_w_idx++];
+        }
+        row_w_idx++;
+    }
+    return true;
+}
+
+void report(const char* name, Time t, std::size_t rows, std::size_t bytes) {
+    print("{:<28} {:>10} {:>12.0f} rows/s {:>8.1f} MB/s", name, t, rows / t.as_seconds(),
+          bytes / 1.0e6 / t.as_seconds());
+}
+
+int main(int argc, char* argv[]) {
+    const std::size_t rows = argc > 1 ? std::stoul(argv[1]) : 200000;
+    const std::size_t cols = 8;
+    const std::string filepath = "csv_read_example/trajectory.csv";
+
+    // write a trajectory-like file
+    std::vector<std::vector<double>> data(rows, std::vector<double>(cols));
+    for (std::size_t r = 0; r < rows; ++r) {
+        data[r][0] = r * 0.001;
+        for (std::size_t c = 1; c < cols; ++c)
+            data[r][c] = std::sin(r * 0.001 * c) * 100.0;
+    }
+    csv_write_rows(filepath, data);
+
+    CsvReader reader(filepath);
+    const std::size_t bytes = reader.size();
+    print("{} rows x {} cols, {:.1f} MB", rows, cols, bytes / 1.0e6);
+
+    std::vector<std::vector<double>> legacy(rows, std::vector<double>(cols));
+    Clock clock;
+    getline_read_rows(filepath, legacy);
+    report("getline + istringstream", clock.get_elapsed_time(), rows, bytes);
+
+    std::vector<std::vector<double>> fast(rows, std::vector<double>(cols));
+    clock.restart();
+    csv_read_rows(filepath, fast);
+    report("csv_read_rows (CsvReader)", clock.get_elapsed_time(), rows, bytes);
+
+    std::vector<std::vector<double>> columns(cols);
+    clock.restart();
+    reader.read_columns(columns);
+    report("CsvReader::read_columns", clock.get_elapsed_time(), rows, bytes);
+
+    std::size_t mismatches = 0;
+    for (std::size_t r = 0; r < rows; ++r) {
+        for (std::size_t c = 0; c < cols; ++c) {
+            if (legacy[r][c] != fast[r][c] || legacy[r][c] != columns[c][r])
+                mismatches++;
+        }
+    }
+    print("{} mismatched values", mismatches);
+
+    // Large files can be parsed on several threads (results are identical)
+    for (std::size_t threads = 2; threads <= (std::max)(ThreadPool::hardware_threads(), std::size_t(4)); threads *= 2) {
+        std::vector<std::vector<double>> parallel(rows, std::vector<double>(cols));
+        clock.restart();
+        csv_read_rows(filepath, parallel, 0, 0, threads);
+        Time t = clock.get_elapsed_time();
+        report(fmt::format("csv_read_rows ({} threads)", threads).c_str(), t, rows, bytes);
+        if (parallel != fast)
+            print("parallel result differs!");
+    }
+
+    // When reading repeatedly, reuse one ThreadPool rather than starting
+    // threads on every call
+    ThreadPool pool;
+    std::vector<std::vector<double>> pooled(rows, std::vector<double>(cols));
+    clock.restart();
+    for (int i = 0; i < 4; ++i)
+        csv_read_rows(filepath, pooled, 0, 0, 0, &pool);
+    report(fmt::format("csv_read_rows (pool of {})", pool.size()).c_str(), clock.get_elapsed_time() / 4.0, rows, bytes);
+    if (pooled != fast)
+        print("pooled result differs!");
+
+    // Large files can be processed in batches with a Cursor
+    std::vector<std::array<double, 2>> batch(4096);
+    CsvReader::Cursor cursor = reader.cursor();
+    double sum = 0;
+    clock.restart();
+    while (std::size_t n = cursor.next(batch)) {
+        for (std::size_t r = 0; r < n; ++r)
+            sum += batch[r][1];
+    }
+    report("Cursor::next (4096 rows)", clock.get_elapsed_time(), rows, bytes);
+
+    // Random access requires scanning to a row unless the file is indexed
+    std::array<double, cols> row;
+    clock.restart();
+    for (std::size_t i = 0; i < 100; ++i)
+        reader.read_row(row, (i * 7919) % rows);
+    print("{:<28} {:>10}", "100 random rows", clock.get_elapsed_time());
+    // The index can be saved next to the file (trajectory.csv.idx) and loaded
+    // by later readers, so the scan only ever happens once
+    reader.build_index();
+    reader.save_index();
+    CsvReader indexed(filepath);
+    indexed.load_index();
+    clock.restart();
+    for (std::size_t i = 0; i < 100; ++i)
+        indexed.read_row(row, (i * 7919) % rows);
+    print("{:<28} {:>10}", "100 random rows (indexed)", clock.get_elapsed_time());
+    return 0;
+}
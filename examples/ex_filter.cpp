@@ -29,6 +29,8 @@ int main() {
     Butterworth hp_filter(2, 0.05, Butterworth::Highpass);
     Butterworth lps_filter(2, 0.05, Butterworth::Lowpass, 50);
     Butterworth hps_filter(2, 0.05, Butterworth::Highpass, 50);
+    // high order filters are more accurate as second-order sections, even in float
+    SosFilter<float> sos_filter(Butterworth::design_sos(8, 0.05, Butterworth::Lowpass));
 
     // number of samples to generate
     int samples = 250;
@@ -40,10 +42,10 @@ int main() {
 
     // initialize data logger to write immediately to file
     Csv csv("filter.csv");
-    csv.write_row("Input", "LPF Output", "HPF Output", "LPF Seeded Output", "HPF Seeded Output");
+    csv.write_row("Input", "LPF Output", "HPF Output", "LPF Seeded Output", "HPF Seeded Output", "LPF8 SOS Output");
 
     // data storage container
-    std::vector<double> data(5);
+    std::vector<double> data(6);
 
     // begin filtering and logging data
     for (int i = 0; i < samples; ++i) {
@@ -56,6 +58,7 @@ int main() {
         data[2] = hp_filter.update(x);
         data[3] = lps_filter.update(x);
         data[4] = hps_filter.update(x);
+        data[5] = sos_filter.update(static_cast<float>(x));
 
         // write to data log buffer
         csv.write_row(data);
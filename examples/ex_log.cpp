@@ -15,6 +15,7 @@
 // Author(s): Evan Pezent (epezent@rice.edu)
 
 #include <Mahi/Util/Logging/Log.hpp>
+#include <Mahi/Util/Logging/BinaryLog.hpp>
 
 using namespace mahi::util;
 
@@ -23,7 +24,7 @@ using namespace mahi::util;
 // levels of severity / formatting.
 
 // custom loggers must start at 1 (the default logger is 0)
-enum { MyLogger = 1 };
+enum { MyLogger = 1, MyAsyncLogger = 2, MyBufferedLogger = 3 };
 
 // custom formatters must define two public static functions:
 // static std::string header() & static std::string format(const Record& record)
@@ -112,6 +113,46 @@ int main() {
     LOG_(MyLogger, Warning) << "This is a custom Warning log";
     LOG_(MyLogger, Error) << "This is an custom Error log";
     LOG_(MyLogger, Fatal) << "This is a custom Fatal log";
-    
+
+    //==========================================================================
+
+    // Loggers can also run asynchronously. In this mode, LOG_ only copies the
+    // record into a lock-free queue, and a background thread does the
+    // formatting and writing. This keeps file and console I/O out of
+    // time-critical loops. The queue capacity and the policy used when it
+    // overflows (Block, DropNewest, DropOldest) are set with AsyncLogOptions.
+    RollingFileWriter<TxtFormatter> async_writer("my_async_log.txt");
+    init_logger<MyAsyncLogger>(Verbose, &async_writer, AsyncLogOptions(1024, AsyncLogOptions::Block));
+    for (int i = 0; i < 1000; ++i)
+        LOG_(MyAsyncLogger, Info) << "This is async log #" << i;
+    // flush() blocks until every record logged so far has been written
+    get_logger<MyAsyncLogger>()->flush();
+
+    //==========================================================================
+
+    // RollingFileWriter can collect records in memory and write them in
+    // batches, which greatly reduces the number of system calls under bursty
+    // logging. RollingFileOptions also selects when data is synced to disk and
+    // whether rolled files are renamed on a background thread.
+    RollingFileWriter<TxtFormatter> buffered_writer("my_buffered_log.txt", 64000, 5, Debug,
+        RollingFileOptions(32768, milliseconds(100), RollingFileOptions::SyncOnRoll, seconds(1), true));
+    init_logger<MyBufferedLogger>(Verbose, &buffered_writer);
+    for (int i = 0; i < 5000; ++i)
+        LOG_(MyBufferedLogger, Info) << "This is buffered log #" << i;
+    get_logger<MyBufferedLogger>()->flush();
+
+    //==========================================================================
+
+    // When even copying a message is too expensive, binary logging defers all
+    // formatting until after the program has run. BLOG stores only a call site
+    // ID, a timestamp, the thread ID and the raw argument values. The format
+    // string uses fmt syntax and is written to the file once per call site.
+    init_binary_logger<DEFAULT_LOGGER>(Verbose, "my_binary_log.blog");
+    for (int i = 0; i < 1000; ++i)
+        BLOG(Info, "This is binary log #{} (x = {:.3f}, tag = {})", i, 0.001 * i, "blog");
+    get_binary_logger<DEFAULT_LOGGER>()->flush();
+    // The file can be decoded to text later (or with the blog_decode tool)
+    decode_binary_log("my_binary_log.blog", "my_binary_log.txt");
+
     return 0;
 }
@@ -0,0 +1,57 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#include <Mahi/Util.hpp>
+
+using namespace mahi::util;
+
+// Usage:
+// Run the example to compare writing a large log of sensor data with File
+// (one system call per write) and MappedFile (a memcpy into the page cache).
+
+int main() {
+    const int rows = 1000000;
+    char line[64];
+    std::size_t bytes = 0;
+
+    // File: each write is a system call
+    File file("mapped_file_example/file.csv");
+    Clock clock;
+    for (int i = 0; i < rows; ++i) {
+        int n = std::snprintf(line, sizeof(line), "%d,%.6f,%.6f\n", i, i * 0.001, i * 0.002);
+        bytes += file.write(line, n);
+    }
+    file.close();
+    Time t_file = clock.get_elapsed_time();
+
+    // MappedFile: space is preallocated and mapped in chunks, so writes are memcpys
+    MappedFile mapped("mapped_file_example/mapped.csv");
+    clock.restart();
+    for (int i = 0; i < rows; ++i) {
+        int n = std::snprintf(line, sizeof(line), "%d,%.6f,%.6f\n", i, i * 0.001, i * 0.002);
+        mapped.write(line, n);
+    }
+    // reserve() hands out space for writing in place
+    char* footer = mapped.reserve(4);
+    std::memcpy(footer, "end\n", 4);
+    mapped.close(); // truncates the file to the length written
+    Time t_mapped = clock.get_elapsed_time();
+
+    print("Wrote {} MB", bytes / 1.0e6);
+    print("File:       {}", t_file);
+    print("MappedFile: {}", t_mapped);
+    return 0;
+}
@@ -0,0 +1,71 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#include <Mahi/Util.hpp>
+#include <thread>
+
+using namespace mahi::util;
+
+double control_law(double x) {
+    PROFILE_FUNCTION();
+    double y = 0;
+    for (int i = 0; i < 200; ++i)
+        y += std::sin(x + i);
+    return y;
+}
+
+void control_loop(const std::string& name, Frequency f, int ticks) {
+    Profiler::set_thread_name(name);
+    Timer timer(f, Timer::WaitMode::Hybrid, false);
+    double x = 0;
+    for (int i = 0; i < ticks; ++i) {
+        {
+            PROFILE_SCOPE("tick");
+            x = control_law(x);
+        }
+        timer.wait();
+    }
+}
+
+int main(int argc, char const *argv[])
+{
+    // measure the cost of an empty profiled scope
+    const int n = 1000000;
+    Profiler::set_buffer_capacity(n + 1); // large enough to hold every event
+    Clock clock;
+    for (int i = 0; i < n; ++i) {
+        PROFILE_SCOPE("empty");
+    }
+    print("PROFILE_SCOPE overhead: {:.1f} ns", clock.get_elapsed_time().as_nanoseconds() / (double)n);
+    Profiler::reset();
+    Profiler::set_buffer_capacity(16384);
+
+    // profile two loops and collect from the main thread
+    Profiler::enable_trace(true);
+    std::thread a(control_loop, "1 kHz loop", 1000_Hz, 1000);
+    std::thread b(control_loop, "100 Hz loop", 100_Hz, 100);
+    for (int i = 0; i < 10; ++i) {
+        sleep(100_ms);
+        Profiler::collect();
+    }
+    a.join();
+    b.join();
+
+    print("{}", Profiler::summary());
+    if (Profiler::save_trace("profile.json"))
+        print("Trace saved to profile.json (open in chrome://tracing or ui.perfetto.dev)");
+    return 0;
+}
@@ -0,0 +1,64 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#include <Mahi/Util.hpp>
+
+using namespace mahi::util;
+
+int main(int argc, char const *argv[])
+{
+    double position = 0;
+    int64 control_ticks = 0;
+
+    // one thread runs 1 kHz control, 100 Hz logging and 10 Hz UI on a 1 ms
+    // base tick, so every UI update sees the same phase of the control loop
+    RateScheduler scheduler(1, Timer::WaitMode::Deadline);
+    scheduler.add_task("control", 1000_Hz, [&]() {
+        position += 0.001;
+        control_ticks++;
+    }, 2);
+    scheduler.add_task("logging", 100_Hz, [&]() {
+        // stand-in for writing a row to a Csv
+        volatile double x = position;
+        (void)x;
+    }, 1);
+    scheduler.add_task("ui", 10_Hz, [&]() {
+        print("position = {:.3f} after {} control ticks", position, control_ticks);
+    });
+
+    print("base period: {}", scheduler.get_base_period(0));
+    scheduler.start();
+    sleep(2_s);
+    scheduler.stop();
+
+    for (std::size_t i = 0; i < scheduler.get_task_count(); ++i) {
+        auto stats = scheduler.get_task_stats(i);
+        print("{:<8} {:>8} runs {:>6} overruns  exec {}", stats.name, stats.runs, stats.overruns, stats.exec_time.summary());
+    }
+    print("missed ticks: {}", scheduler.get_misses(0));
+
+    // rates which are not harmonic cannot share a base tick: 1000 and 60 Hz
+    // have a GCD of 2 ns. With thread -1, the 60 Hz display task is put on
+    // its own thread instead, and forcing it onto the control thread fails.
+    RateScheduler mixed(2);
+    mixed.add_task("control", 1000_Hz, [&]() { control_ticks++; });
+    int display = mixed.add_task("display", 60_Hz, [&]() {});
+    print("display on thread {}, base periods {} and {}", mixed.get_task_stats(display).thread,
+          mixed.get_base_period(0), mixed.get_base_period(1));
+    int rejected = mixed.add_task("display2", 60_Hz, [&]() {}, 0, 0);
+    print("forcing display2 onto thread 0 returned {}", rejected);
+    return 0;
+}
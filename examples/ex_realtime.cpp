@@ -0,0 +1,41 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#include <Mahi/Util.hpp>
+
+using namespace mahi::util;
+
+int main(int argc, char const *argv[])
+{
+    RealtimeConfig config;
+    config.policy         = RealtimeConfig::Fifo;
+    config.priority       = 80;
+    config.cpus           = {0};
+    config.prefault_stack = 512 * 1024;
+    config.prefault_heap  = 16 * 1024 * 1024;
+
+    // steps that need privileges (e.g. scheduling, mlockall) fail gracefully
+    RealtimeStatus status = configure_realtime(config);
+    print("{}", status.summary());
+    print("isolated CPUs: {}", get_isolated_cpus().size());
+
+    Timer timer(1000_Hz, Timer::WaitMode::Deadline, false);
+    timer.enable_statistics();
+    for (int i = 0; i < 2000; ++i)
+        timer.wait();
+    print("lateness: {}", timer.get_lateness().summary());
+    return 0;
+}
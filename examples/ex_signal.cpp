@@ -0,0 +1,51 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+
+#include <Mahi/Util.hpp>
+
+using namespace mahi::util;
+
+// Usage:
+// Run the example to zero-phase filter and downsample a simulated one hour,
+// 1 kHz recording of several joints, as a post-processing script would.
+
+int main() {
+    const std::size_t joints  = 8;
+    const std::size_t samples = 3600 * 1000;
+
+    // noisy joint positions
+    std::vector<std::vector<double>> data(joints, std::vector<double>(samples));
+    for (std::size_t j = 0; j < joints; ++j) {
+        for (std::size_t i = 0; i < samples; ++i)
+            data[j][i] = std::sin(2 * PI * 0.5 * i / 1000.0 + j) + 0.1 * random_range(-1.0, 1.0);
+    }
+
+    // zero-phase 4th order 20 Hz lowpass on every joint in parallel
+    ThreadPool pool;
+    Clock clock;
+    filtfilt(Butterworth::design_sos(4, 20_Hz, 1000_Hz), data, &pool);
+    print("filtfilt of {} x {} samples on {} threads: {} ms", joints, samples, pool.size(),
+          clock.get_elapsed_time().as_milliseconds());
+
+    // downsample to 100 Hz
+    clock.restart();
+    std::vector<double> small = resample(data[0], 1000_Hz, 100_Hz);
+    print("resampled joint 0 from {} to {} samples: {} ms", samples, small.size(),
+          clock.get_elapsed_time().as_milliseconds());
+
+    return 0;
+}
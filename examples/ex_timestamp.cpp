@@ -0,0 +1,72 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#include <Mahi/Util.hpp>
+#include <iomanip>
+#include <sstream>
+
+using namespace mahi::util;
+
+// Usage:
+// Run the example to see how long it takes to create and format the
+// Timestamps used by every log record. The first result reproduces the
+// std::ostringstream based formatting used before, for comparison.
+
+std::string ostringstream_format(const Timestamp& t) {
+    std::ostringstream ss;
+    ss << t.year << "-"
+    << std::setfill('0') << std::setw(2) << t.month << ("-")
+    << std::setfill('0') << std::setw(2) << t.mday << (" ")
+    << std::setfill('0') << std::setw(2) << t.hour << (":")
+    << std::setfill('0') << std::setw(2) << t.min << (":")
+    << std::setfill('0') << std::setw(2) << t.sec << (".")
+    << std::setfill('0') << std::setw(3) << t.millisec;
+    return ss.str();
+}
+
+// prevents the compiler from optimizing away benchmarked work
+volatile std::size_t g_sink = 0;
+
+template <typename F>
+void bench(const char* name, int n, F f) {
+    Clock clock;
+    for (int i = 0; i < n; ++i)
+        f();
+    Time t = clock.get_elapsed_time();
+    print("{:<36} {:8.1f} ns", name, t.as_nanoseconds() / (double)n);
+}
+
+int main() {
+    const int n = 1000000;
+    Timestamp ts;
+
+    print("Per-call cost:");
+    bench("Timestamp()", n, [&]() { Timestamp t; g_sink += t.millisec; });
+    bench("Timestamp(RealtimeCoarse)", n, [&]() { Timestamp t(Timestamp::RealtimeCoarse); g_sink += t.millisec; });
+    bench("ostringstream formatting", n, [&]() { g_sink += ostringstream_format(ts).size(); });
+    bench("yyyy_mm_dd_hh_mm_ss_mmm()", n, [&]() { g_sink += ts.yyyy_mm_dd_hh_mm_ss_mmm().size(); });
+    bench("write_yyyy_mm_dd_hh_mm_ss_mmm(buffer)", n, [&]() {
+        char buffer[Timestamp::MaxSize];
+        g_sink += ts.write_yyyy_mm_dd_hh_mm_ss_mmm(buffer) - buffer;
+    });
+
+    LogRecord record(Info, LOG_GET_FUNC(), __LINE__, LOG_GET_FILE());
+    record << "pos " << 1.2345 << " vel " << 6.789;
+    bench("TxtFormatter::format(record)", n, [&]() { g_sink += TxtFormatter::format(record).size(); });
+
+    print("{} == {}", ostringstream_format(ts), ts.yyyy_mm_dd_hh_mm_ss_mmm());
+    return 0;
+}
@@ -6,6 +6,7 @@
 #include <Mahi/Util/Event.hpp>
 #include <Mahi/Util/NonCopyable.hpp>
 #include <Mahi/Util/Random.hpp>
+#include <Mahi/Util/Realtime.hpp>
 #include <Mahi/Util/StlStreams.hpp>
 #include <Mahi/Util/System.hpp>
 #include <Mahi/Util/Types.hpp>
@@ -14,27 +15,43 @@
 #include <Mahi/Util/Concurrency/Mutex.hpp>
 #include <Mahi/Util/Concurrency/NamedMutex.hpp>
 #include <Mahi/Util/Concurrency/Spinlock.hpp>
+#include <Mahi/Util/Concurrency/ThreadPool.hpp>
 
 #include <Mahi/Util/Math/Butterworth.hpp>
 #include <Mahi/Util/Math/Chirp.hpp>
 #include <Mahi/Util/Math/Constants.hpp>
 #include <Mahi/Util/Math/Differentiator.hpp>
 #include <Mahi/Util/Math/Filter.hpp>
+#include <Mahi/Util/Math/FilterBank.hpp>
+#include <Mahi/Util/Math/FixedFilter.hpp>
 #include <Mahi/Util/Math/Functions.hpp>
 #include <Mahi/Util/Math/Integrator.hpp>
+#include <Mahi/Util/Math/Signal.hpp>
+#include <Mahi/Util/Math/SosFilter.hpp>
 #include <Mahi/Util/Math/TimeFunction.hpp>
 #include <Mahi/Util/Math/Waveform.hpp>
 
+#include <Mahi/Util/Logging/AsyncCsv.hpp>
+#include <Mahi/Util/Logging/BinaryLog.hpp>
+#include <Mahi/Util/Logging/BinaryRecorder.hpp>
 #include <Mahi/Util/Logging/Csv.hpp>
+#include <Mahi/Util/Logging/CsvReader.hpp>
+#include <Mahi/Util/Logging/CsvSchema.hpp>
 #include <Mahi/Util/Logging/Log.hpp>
 #include <Mahi/Util/Logging/File.hpp>
+#include <Mahi/Util/Logging/MappedFile.hpp>
 
+#include <Mahi/Util/Templates/AlignedAllocator.hpp>
+#include <Mahi/Util/Templates/MPSCQueue.hpp>
 #include <Mahi/Util/Templates/RingBuffer.hpp>
 #include <Mahi/Util/Templates/SPSCQueue.hpp>
 #include <Mahi/Util/Templates/Singleton.hpp>
 
 #include <Mahi/Util/Timing/Clock.hpp>
 #include <Mahi/Util/Timing/Frequency.hpp>
+#include <Mahi/Util/Timing/LatencyHistogram.hpp>
+#include <Mahi/Util/Timing/Profiler.hpp>
+#include <Mahi/Util/Timing/RateScheduler.hpp>
 #include <Mahi/Util/Timing/Time.hpp>
 #include <Mahi/Util/Timing/Timer.hpp>
 #include <Mahi/Util/Timing/Timestamp.hpp>
@@ -0,0 +1,75 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#pragma once
+
+#include <Mahi/Util/NonCopyable.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mahi {
+namespace util {
+
+/// A fixed set of worker threads for data parallel work. parallel_for()
+/// hands out the indices of a loop to the workers and the calling thread,
+/// and returns once every index has been processed.
+class ThreadPool : public NonCopyable {
+public:
+    /// Constructor. The pool runs tasks on threads - 1 workers plus the
+    /// calling thread. A value of 0 uses the number of hardware threads.
+    explicit ThreadPool(std::size_t threads = 0);
+
+    /// Destructor (stops the workers)
+    ~ThreadPool();
+
+    /// Returns the number of threads tasks run on (including the caller)
+    std::size_t size() const;
+
+    /// Calls task(i) for every i in [0, count), distributing the indices
+    /// dynamically over the pool. Blocks until all calls have returned.
+    /// Concurrent calls are serialized. Must not be called from a task.
+    void parallel_for(std::size_t count, const std::function<void(std::size_t)>& task);
+
+    /// Returns the number of hardware threads (at least 1)
+    static std::size_t hardware_threads();
+
+private:
+    /// Worker thread function
+    void run();
+
+    /// Runs indices of the current loop until none remain
+    void work();
+
+private:
+    std::vector<std::thread> workers_;                 ///< worker threads
+    std::mutex call_mutex_;                            ///< serializes parallel_for calls
+    std::mutex mutex_;                                 ///< guards the loop state
+    std::condition_variable start_;                    ///< signals a new loop (or stop)
+    std::condition_variable done_;                     ///< signals workers finished
+    const std::function<void(std::size_t)>* task_;    ///< current loop body
+    std::size_t count_;                                ///< current loop size
+    std::atomic<std::size_t> next_;                    ///< next index to run
+    std::size_t pending_;                              ///< workers still in the current loop
+    std::size_t generation_;                           ///< incremented for each loop
+    bool stop_;                                        ///< workers should exit?
+};
+
+} // namespace util
+} // namespace mahi
@@ -0,0 +1,186 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#pragma once
+
+#include <Mahi/Util/Logging/Csv.hpp>
+#include <Mahi/Util/NonCopyable.hpp>
+#include <Mahi/Util/Timing/Time.hpp>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mahi {
+namespace util {
+
+/// Configures an AsyncCsv
+struct AsyncCsvOptions {
+    /// Constructor
+    AsyncCsvOptions(std::size_t capacity      = 65536,
+                    Time        poll_period   = milliseconds(1),
+                    Csv::FloatFormat format   = Csv::General,
+                    std::size_t precision     = 6,
+                    std::size_t buffer_size   = 65536) :
+        capacity(capacity),
+        poll_period(poll_period),
+        format(format),
+        precision(precision),
+        buffer_size(buffer_size) {}
+
+    std::size_t capacity;    ///< maximum number of rows waiting to be written
+    Time poll_period;        ///< how long the writer thread sleeps when idle
+    Csv::FloatFormat format; ///< format of values
+    std::size_t precision;   ///< precision of values
+    std::size_t buffer_size; ///< bytes formatted before writing to the file
+};
+
+/// Statistics of an AsyncCsv
+struct AsyncCsvStats {
+    uint64 rows_written;         ///< rows written to the file
+    uint64 rows_dropped;         ///< rows discarded because the ring was full
+    std::size_t high_water_mark; ///< maximum number of rows waiting at once
+    std::size_t capacity;        ///< capacity of the ring in rows
+    Time format_time;            ///< total time spent formatting rows
+    Time write_time;             ///< total time spent writing to the file
+};
+
+/// A CSV file written by a background thread. write_row() only copies the
+/// raw values into a preallocated lock-free ring, so no formatting, allocation
+/// or file I/O happens on the calling thread. If the ring is full the row is
+/// dropped (and counted) rather than blocking the caller. Values are stored
+/// as doubles. write_row() must only be called from one thread at a time.
+class AsyncCsv : public NonCopyable {
+public:
+    /// Default constructor
+    AsyncCsv();
+
+    /// Constructor with filepath and header provided (opens file)
+    AsyncCsv(const std::string& filepath, const std::vector<std::string>& header,
+             const AsyncCsvOptions& options = AsyncCsvOptions(), WriteMode w_mode = Truncate,
+             OpenMode o_mode = OpenOrCreate);
+
+    /// Destructor (writes remaining rows)
+    ~AsyncCsv();
+
+    /// Opens the file, writes the header row and starts the writer thread.
+    /// The number of columns of every row is the size of the header.
+    bool open(const std::string& filepath, const std::vector<std::string>& header,
+              const AsyncCsvOptions& options = AsyncCsvOptions(), WriteMode w_mode = Truncate,
+              OpenMode o_mode = OpenOrCreate);
+
+    /// Opens the file without a header row, with rows of columns values
+    bool open(const std::string& filepath, std::size_t columns,
+              const AsyncCsvOptions& options = AsyncCsvOptions(), WriteMode w_mode = Truncate,
+              OpenMode o_mode = OpenOrCreate);
+
+    /// Queues a row with one value per column. Returns false if the row was
+    /// dropped.
+    template <typename... Args>
+    bool write_row(const Args&... values);
+
+    /// Queues a row from a 1D container with one value per column
+    template <typename Container1D>
+    bool write_container(const Container1D& values);
+
+    /// Queues a row from an array of column_count() values
+    bool write_values(const double* values);
+
+    /// Blocks until all queued rows have been written to the file
+    void flush();
+
+    /// Writes remaining rows, stops the writer thread and closes the file
+    void close();
+
+    /// Returns true if the file is open
+    bool is_open() const;
+
+    /// Returns the number of columns
+    std::size_t column_count() const;
+
+    /// Returns the writer statistics
+    AsyncCsvStats get_stats() const;
+
+private:
+    /// Opens the file, buffers the header (if any) and starts the writer thread
+    bool start(const std::string& filepath, std::size_t columns, const std::vector<std::string>* header,
+               const AsyncCsvOptions& options, WriteMode w_mode, OpenMode o_mode);
+
+    /// Returns the slot for the next row, or nullptr if the ring is full
+    double* reserve_row();
+
+    /// Publishes the row returned by reserve_row()
+    void commit_row();
+
+    /// Reports a row with the wrong number of values (returns false)
+    bool reject_row(std::size_t count) const;
+
+    /// Writer thread function
+    void run();
+
+    /// Writes the formatted rows
+    void write_buffer();
+
+private:
+    File file_;                        ///< CSV file
+    AsyncCsvOptions options_;          ///< options
+    std::size_t columns_;              ///< values per row
+    std::vector<double> ring_;         ///< capacity x columns values
+    fmt::memory_buffer buffer_;        ///< rows formatted by the writer thread
+    std::thread writer_;               ///< writer thread
+    std::atomic<bool> running_;        ///< writer thread should keep running?
+    std::atomic<uint64> dropped_;      ///< rows dropped
+    std::atomic<std::size_t> high_water_; ///< maximum rows queued
+    std::atomic<int64> format_ns_;     ///< nanoseconds spent formatting
+    std::atomic<int64> write_ns_;      ///< nanoseconds spent writing
+    std::atomic<uint64> written_;      ///< rows written to the file
+    // head and tail are counters (not indices) on separate cache lines
+    char padding0_[64];
+    std::atomic<uint64> head_;         ///< rows queued (written by caller)
+    char padding1_[64 - sizeof(std::atomic<uint64>)];
+    std::atomic<uint64> tail_;         ///< rows formatted (written by writer thread)
+    char padding2_[64 - sizeof(std::atomic<uint64>)];
+};
+
+template <typename... Args>
+bool AsyncCsv::write_row(const Args&... values) {
+    static_assert(sizeof...(Args) > 0, "write_row requires at least one value");
+    if (sizeof...(Args) != columns_)
+        return reject_row(sizeof...(Args));
+    double* slot = reserve_row();
+    if (!slot)
+        return false;
+    using expander = int[];
+    (void)expander{0, (*slot++ = static_cast<double>(values), 0)...};
+    commit_row();
+    return true;
+}
+
+template <typename Container1D>
+bool AsyncCsv::write_container(const Container1D& values) {
+    if (values.size() != columns_)
+        return reject_row(values.size());
+    double* slot = reserve_row();
+    if (!slot)
+        return false;
+    for (std::size_t j = 0; j < columns_; ++j)
+        slot[j] = static_cast<double>(values[j]);
+    commit_row();
+    return true;
+}
+
+} // namespace util
+} // namespace mahi
@@ -0,0 +1,380 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#pragma once
+
+#include <Mahi/Util/Concurrency/Mutex.hpp>
+#include <Mahi/Util/Logging/Detail/LogUtil.hpp>
+#include <Mahi/Util/Logging/File.hpp>
+#include <Mahi/Util/Logging/Formatters/TxtFormatter.hpp>
+#include <Mahi/Util/Logging/Log.hpp>
+#include <Mahi/Util/Templates/Singleton.hpp>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Binary logging defers message formatting until after the program has run.
+// Each BLOG call site registers a descriptor (severity, function, line, file,
+// format string and argument types) the first time it executes. At runtime
+// only the site ID, a timestamp, the thread ID and the raw argument bytes are
+// appended to a binary file. The file can later be rendered to text with
+// decode_binary_log() or the blog_decode tool. Format strings use fmt syntax.
+// Every time a file is opened a new session header is written, and site
+// descriptors are written again before their first record in that session,
+// so each file (and each run appended to it) can be decoded on its own.
+//
+//     init_binary_logger<DEFAULT_LOGGER>(Verbose, "robot.blog");
+//     BLOG(Info, "pos {} vel {:.3f}", x, v);
+
+namespace mahi {
+namespace util {
+
+//==============================================================================
+// CALL SITE DESCRIPTORS
+//==============================================================================
+
+/// Type tags for binary log arguments
+enum BinaryLogType {
+    BlogBool    = 1,
+    BlogChar    = 2,
+    BlogInt8    = 3,
+    BlogInt16   = 4,
+    BlogInt32   = 5,
+    BlogInt64   = 6,
+    BlogUInt8   = 7,
+    BlogUInt16  = 8,
+    BlogUInt32  = 9,
+    BlogUInt64  = 10,
+    BlogFloat32 = 11,
+    BlogFloat64 = 12,
+    BlogString  = 13
+};
+
+/// Static description of a binary log call site
+struct BinaryLogSite {
+    uint32 id;                ///< unique site ID
+    Severity severity;        ///< severity of the call site
+    const char* func;         ///< function signature
+    size_t line;              ///< line number
+    const char* file;         ///< file name
+    const char* format;       ///< fmt style format string
+    std::vector<uint8> types; ///< BinaryLogType of each argument
+};
+
+/// Registers a new call site and returns its ID (thread-safe)
+uint32 register_binary_log_site(Severity severity, const char* func, size_t line,
+                                const char* file, const char* format,
+                                const uint8* types, std::size_t count);
+
+/// Gets a copy of a registered call site (thread-safe)
+BinaryLogSite get_binary_log_site(uint32 id);
+
+/// Decodes a binary log file, calling callback with each reconstructed LogRecord
+bool decode_binary_log(const std::string& filepath,
+                       const std::function<void(const LogRecord&)>& callback);
+
+/// Decodes a binary log file to a text file using a Formatter
+template <class Formatter = TxtFormatter>
+bool decode_binary_log(const std::string& in_filepath, const std::string& out_filepath) {
+    File out(out_filepath, WriteMode::Truncate);
+    if (!out.is_open())
+        return false;
+    out.write(Formatter::header());
+    return decode_binary_log(in_filepath, [&](const LogRecord& record) {
+        out.write(Formatter::format(record));
+    });
+}
+
+namespace detail {
+
+//==============================================================================
+// ARGUMENT ENCODING
+//==============================================================================
+
+/// Appends the raw bytes of a value
+template <typename T>
+inline char* blog_put(char* p, const T& value) {
+    std::memcpy(p, &value, sizeof(T));
+    return p + sizeof(T);
+}
+
+/// Maximum number of bytes stored for a string argument
+const std::size_t BLOG_MAX_STRING = 0xFFFF;
+
+/// Encoding traits for supported argument types (unsupported types fail to compile)
+template <typename T, typename Enable = void>
+struct BlogArg;
+
+template <>
+struct BlogArg<bool> {
+    static uint8 type() { return BlogBool; }
+    static std::size_t size(bool) { return 1; }
+    static char* encode(char* p, bool v) { *p = v ? 1 : 0; return p + 1; }
+};
+
+template <>
+struct BlogArg<char> {
+    static uint8 type() { return BlogChar; }
+    static std::size_t size(char) { return 1; }
+    static char* encode(char* p, char v) { *p = v; return p + 1; }
+};
+
+template <typename T>
+struct BlogArg<T, typename std::enable_if<std::is_integral<T>::value &&
+                                          !std::is_same<T, bool>::value &&
+                                          !std::is_same<T, char>::value>::type> {
+    static uint8 type() {
+        return static_cast<uint8>((std::is_signed<T>::value ? BlogInt8 : BlogUInt8) +
+                                  (sizeof(T) == 1 ? 0 : sizeof(T) == 2 ? 1 : sizeof(T) == 4 ? 2 : 3));
+    }
+    static std::size_t size(T) { return sizeof(T); }
+    static char* encode(char* p, T v) { return blog_put(p, v); }
+};
+
+template <typename T>
+struct BlogArg<T, typename std::enable_if<std::is_enum<T>::value>::type> {
+    static uint8 type() { return BlogInt64; }
+    static std::size_t size(T) { return sizeof(int64); }
+    static char* encode(char* p, T v) { return blog_put(p, static_cast<int64>(v)); }
+};
+
+template <>
+struct BlogArg<float> {
+    static uint8 type() { return BlogFloat32; }
+    static std::size_t size(float) { return sizeof(float); }
+    static char* encode(char* p, float v) { return blog_put(p, v); }
+};
+
+template <>
+struct BlogArg<double> {
+    static uint8 type() { return BlogFloat64; }
+    static std::size_t size(double) { return sizeof(double); }
+    static char* encode(char* p, double v) { return blog_put(p, v); }
+};
+
+template <>
+struct BlogArg<long double> {
+    static uint8 type() { return BlogFloat64; }
+    static std::size_t size(long double) { return sizeof(double); }
+    static char* encode(char* p, long double v) { return blog_put(p, static_cast<double>(v)); }
+};
+
+struct BlogStringArg {
+    static uint8 type() { return BlogString; }
+    static std::size_t length(const char* v, std::size_t n) {
+        return v ? (n < BLOG_MAX_STRING ? n : BLOG_MAX_STRING) : 0;
+    }
+    static char* encode(char* p, const char* v, std::size_t n) {
+        uint16 length = static_cast<uint16>(BlogStringArg::length(v, n));
+        p = blog_put(p, length);
+        std::memcpy(p, v, length);
+        return p + length;
+    }
+};
+
+template <>
+struct BlogArg<const char*> : BlogStringArg {
+    static std::size_t size(const char* v) { return 2 + length(v, v ? std::strlen(v) : 0); }
+    static char* encode(char* p, const char* v) {
+        return BlogStringArg::encode(p, v, v ? std::strlen(v) : 0);
+    }
+};
+
+template <>
+struct BlogArg<char*> : BlogArg<const char*> {};
+
+template <>
+struct BlogArg<std::string> : BlogStringArg {
+    static std::size_t size(const std::string& v) { return 2 + length(v.data(), v.size()); }
+    static char* encode(char* p, const std::string& v) {
+        return BlogStringArg::encode(p, v.data(), v.size());
+    }
+};
+
+/// Empty type carrying the decayed argument types of a call site
+template <typename... Args>
+struct BlogSignature {};
+
+/// Deduces the BlogSignature of a call site (only used in unevaluated context)
+template <typename... Args>
+BlogSignature<typename std::decay<Args>::type...> blog_signature(const char* format, const Args&... args);
+
+/// Registers a call site from its BlogSignature
+template <typename... Args>
+inline uint32 register_blog_site(Severity severity, const char* func, size_t line,
+                                 const char* file, const char* format,
+                                 BlogSignature<Args...>) {
+    const uint8 types[] = {0, BlogArg<Args>::type()...};
+    return register_binary_log_site(severity, func, line, file, format, types + 1,
+                                    sizeof...(Args));
+}
+
+inline std::size_t blog_size() { return 0; }
+
+template <typename Arg, typename... Args>
+inline std::size_t blog_size(const Arg& arg, const Args&... args) {
+    return BlogArg<typename std::decay<Arg>::type>::size(arg) + blog_size(args...);
+}
+
+inline char* blog_encode(char* p) { return p; }
+
+template <typename Arg, typename... Args>
+inline char* blog_encode(char* p, const Arg& arg, const Args&... args) {
+    return blog_encode(BlogArg<typename std::decay<Arg>::type>::encode(p, arg), args...);
+}
+
+/// Returns the calling thread's ID, cached per thread
+uint32 blog_thread_id();
+
+} // namespace detail
+
+//==============================================================================
+// BINARY LOG WRITER
+//==============================================================================
+
+/// Buffers binary log records in memory and writes them to a rolling set of files
+class BinaryLogWriter : NonCopyable {
+public:
+    /// Constructor. Files are rolled when they exceed max_file_size, keeping
+    /// at most max_files. Records are written in blocks of buffer_size bytes.
+    BinaryLogWriter(const std::string& filename,
+                    size_t max_file_size  = 0,
+                    int max_files         = 0,
+                    Severity max_severity = Debug,
+                    std::size_t buffer_size = 65536);
+
+    /// Destructor. Writes any buffered records.
+    ~BinaryLogWriter();
+
+    /// Appends a record for a registered call site
+    template <typename... Args>
+    void log(uint32 site, const Args&... args) {
+        const std::size_t size = RECORD_HEADER_SIZE + detail::blog_size(args...);
+        const int64 time = Timestamp::epoch_microseconds(MAHI_LOG_TIME_SOURCE);
+        const uint32 tid = detail::blog_thread_id();
+        Lock lock(mutex_);
+        char* p = begin_record(site, size);
+        p = detail::blog_put(p, static_cast<uint8>('R'));
+        p = detail::blog_put(p, site);
+        p = detail::blog_put(p, time);
+        p = detail::blog_put(p, tid);
+        detail::blog_encode(p, args...);
+        used_ += size;
+        file_size_ += static_cast<off_t>(size);
+    }
+
+    /// Writes buffered records to the file
+    void flush();
+
+    Severity get_max_severity() const { return max_severity_; }
+
+    void set_max_severity(Severity severity) { max_severity_ = severity; }
+
+    bool check_severity(Severity severity) const { return severity <= max_severity_; }
+
+private:
+    /// Size of the fixed part of a record (kind, site, time, tid)
+    static const std::size_t RECORD_HEADER_SIZE = 1 + 4 + 8 + 4;
+
+    /// Opens/rolls files, emits the site descriptor if needed, and returns a
+    /// pointer to size bytes of buffer space
+    char* begin_record(uint32 site, std::size_t size);
+
+    /// Appends bytes to the buffer
+    void append(const void* data, std::size_t size);
+
+    void write_buffer();
+    void write_session_header();
+    void write_site(uint32 site);
+    void open_log_file();
+    void roll_log_files();
+    std::string build_file_name(int file_number = 0);
+
+private:
+    Mutex mutex_;
+    File file_;
+    off_t file_size_;
+    const off_t max_file_size_;
+    const int last_file_number_;
+    std::string file_ext_;
+    std::string filename_no_ext_;
+    bool first_write_;
+    Severity max_severity_;
+    std::vector<char> buffer_;  ///< pending bytes
+    std::size_t used_;          ///< number of bytes used in buffer_
+    std::vector<bool> emitted_; ///< site descriptors written to the current file
+};
+
+//==============================================================================
+// BINARY LOGGER
+//==============================================================================
+
+/// Binary logger instance, accessed through the BLOG_ macros
+template <int instance>
+class BinaryLogger : public Singleton<BinaryLogger<instance> >, public BinaryLogWriter {
+public:
+    BinaryLogger(Severity max_severity,
+                 const std::string& filename,
+                 size_t max_file_size = 0,
+                 int max_files        = 0) :
+        BinaryLogWriter(filename, max_file_size, max_files, max_severity)
+    {}
+};
+
+/// Gets a binary logger instance
+template <int instance>
+inline BinaryLogger<instance>* get_binary_logger() {
+    return BinaryLogger<instance>::get_instance();
+}
+
+/// Initializes a binary logger writing to a rolling set of files
+template <int instance>
+inline BinaryLogger<instance>& init_binary_logger(Severity max_severity,
+                                                  const char* filename,
+                                                  size_t max_file_size = 0,
+                                                  int max_files = 0) {
+    static BinaryLogger<instance> logger(max_severity, filename, max_file_size, max_files);
+    return logger;
+}
+
+} // namespace util
+} // namespace mahi
+
+//==============================================================================
+// BINARY LOGGING MACRO FUNCTIONS
+//==============================================================================
+
+/// Binary log severity level checker for specific logger instance
+#define IF_BLOG_(instance, severity)                                            \
+    if (!mahi::util::get_binary_logger<instance>() ||                           \
+        !mahi::util::get_binary_logger<instance>()->check_severity(severity)) { \
+        ;                                                                       \
+    } else
+
+/// Main binary logging macro for specific logger instance
+#define BLOG_(instance, severity, format, ...)                                               \
+    IF_BLOG_(instance, severity)                                                             \
+    do {                                                                                     \
+        static const mahi::util::uint32 mahi_blog_site = mahi::util::detail::register_blog_site( \
+            severity, LOG_GET_FUNC(), __LINE__, LOG_GET_FILE(), format,                      \
+            decltype(mahi::util::detail::blog_signature(format, ##__VA_ARGS__))());          \
+        mahi::util::get_binary_logger<instance>()->log(mahi_blog_site, ##__VA_ARGS__);       \
+    } while (0)
+
+/// Main binary logging macro for the default logger instance
+#define BLOG(severity, format, ...) BLOG_(DEFAULT_LOGGER, severity, format, ##__VA_ARGS__)
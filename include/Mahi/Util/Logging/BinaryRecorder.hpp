@@ -0,0 +1,304 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#pragma once
+
+#include <Mahi/Util/Logging/Csv.hpp>
+#include <Mahi/Util/Logging/Detail/FileMapping.hpp>
+#include <Mahi/Util/Logging/File.hpp>
+#include <Mahi/Util/NonCopyable.hpp>
+#include <Mahi/Util/Types.hpp>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// A BinaryRecorder is a high-rate alternative to Csv for fixed-width numeric
+// rows. Rows are buffered column-wise and written in chunks, so recording a
+// row costs a few stores and the file is a fraction of the size of text.
+// BinaryRecordingReader memory-maps a recording and exposes each column as
+// contiguous typed spans, one per chunk, without copying (column_chunks).
+// column() returns a whole column as one span, which is a copy unless the
+// recording is a single chunk. binary_recording_to_csv() converts a recording
+// to CSV.
+//
+//     BinaryRecorder rec("data.rec", {record_column<double>("time"),
+//                                     record_column<float>("position"),
+//                                     record_column<int32>("state")});
+//     rec.record(t, x, s);
+//     ...
+//     BinaryRecordingReader reader("data.rec");
+//     auto position = reader.column<float>("position");
+//
+// File layout (native byte order, flagged in the header and checked by the
+// reader; all blocks 8 byte aligned):
+//
+//     "MAHIBREC" | uint32 version | uint32 flags | uint32 columns | uint64 chunk rows |
+//     columns x (uint8 type | uint8 0 | uint16 name size | name) | padding
+//     chunks  x (uint64 rows | columns x (rows x value | padding))
+
+namespace mahi {
+namespace util {
+
+//==============================================================================
+// SCHEMA
+//==============================================================================
+
+/// Data type of a BinaryRecorder column
+enum RecordType {
+    RecordInt8    = 1,
+    RecordInt16   = 2,
+    RecordInt32   = 3,
+    RecordInt64   = 4,
+    RecordUInt8   = 5,
+    RecordUInt16  = 6,
+    RecordUInt32  = 7,
+    RecordUInt64  = 8,
+    RecordFloat32 = 9,
+    RecordFloat64 = 10
+};
+
+/// Returns the size in bytes of a RecordType (0 if invalid)
+std::size_t record_type_size(RecordType type);
+
+/// Returns the name of a RecordType (e.g. "float64")
+const char* record_type_name(RecordType type);
+
+/// Name and type of a BinaryRecorder column
+struct RecordColumn {
+    RecordColumn(const std::string& name = "", RecordType type = RecordFloat64) : name(name), type(type) {}
+    std::string name; ///< column name
+    RecordType type;  ///< column data type
+};
+
+namespace detail {
+
+/// Maps an arithmetic type to its RecordType
+template <typename T, bool Float = std::is_floating_point<T>::value, bool Signed = std::is_signed<T>::value, std::size_t Size = sizeof(T)>
+struct record_type_of;
+
+template <typename T> struct record_type_of<T, false, true,  1> { static const RecordType value = RecordInt8;    };
+template <typename T> struct record_type_of<T, false, true,  2> { static const RecordType value = RecordInt16;   };
+template <typename T> struct record_type_of<T, false, true,  4> { static const RecordType value = RecordInt32;   };
+template <typename T> struct record_type_of<T, false, true,  8> { static const RecordType value = RecordInt64;   };
+template <typename T> struct record_type_of<T, false, false, 1> { static const RecordType value = RecordUInt8;   };
+template <typename T> struct record_type_of<T, false, false, 2> { static const RecordType value = RecordUInt16;  };
+template <typename T> struct record_type_of<T, false, false, 4> { static const RecordType value = RecordUInt32;  };
+template <typename T> struct record_type_of<T, false, false, 8> { static const RecordType value = RecordUInt64;  };
+template <typename T> struct record_type_of<T, true,  true,  4> { static const RecordType value = RecordFloat32; };
+template <typename T> struct record_type_of<T, true,  true,  8> { static const RecordType value = RecordFloat64; };
+
+/// Converts value to type and stores it at dst
+template <typename T>
+inline void record_store(char* dst, RecordType type, T value);
+
+/// Converts n values of type from src to out
+template <typename T>
+inline void record_load(const char* src, RecordType type, std::size_t n, T* out);
+
+} // namespace detail
+
+/// Returns the RecordType of an arithmetic type
+template <typename T>
+RecordType record_type() {
+    static_assert(std::is_arithmetic<T>::value, "BinaryRecorder columns must be arithmetic types");
+    return detail::record_type_of<T>::value;
+}
+
+/// Makes a RecordColumn with the RecordType of T
+template <typename T>
+RecordColumn record_column(const std::string& name) {
+    return RecordColumn(name, record_type<T>());
+}
+
+//==============================================================================
+// RECORDER
+//==============================================================================
+
+/// Appends fixed-width rows to a chunked columnar binary file
+class BinaryRecorder : public NonCopyable {
+public:
+    /// Default constructor
+    BinaryRecorder();
+
+    /// Constructor with filepath and schema provided (opens file)
+    BinaryRecorder(const std::string& filepath, const std::vector<RecordColumn>& schema, std::size_t chunk_rows = 4096);
+
+    /// Destructor (writes buffered rows)
+    ~BinaryRecorder();
+
+    /// Creates a recording file and writes its header. Rows are buffered and
+    /// written chunk_rows at a time.
+    bool open(const std::string& filepath, const std::vector<RecordColumn>& schema, std::size_t chunk_rows = 4096);
+
+    /// Records a row with one value per column. Values are converted to the
+    /// column types.
+    template <typename... Args>
+    bool record(const Args&... values);
+
+    /// Records a row from a 1D container with one value per column
+    template <typename Container1D>
+    bool record_row(const Container1D& values);
+
+    /// Writes buffered rows to the file as a (partial) chunk
+    bool flush();
+
+    /// Writes buffered rows and closes the file
+    void close();
+
+    /// Returns true if the file is open
+    bool is_open() const;
+
+    /// Returns the number of rows recorded since the file was opened
+    uint64 rows() const;
+
+    /// Returns the schema
+    const std::vector<RecordColumn>& schema() const;
+
+private:
+    /// Stores a value in column col of the current row
+    template <typename T>
+    void store(std::size_t col, T value);
+
+    /// Checks the number of values in a row
+    bool check_row(std::size_t count) const;
+
+    /// Completes the current row
+    bool commit_row();
+
+    /// Writes the buffered chunk
+    bool write_chunk();
+
+private:
+    File file_;                        ///< recording file
+    std::vector<RecordColumn> schema_; ///< column names and types
+    std::vector<std::size_t> sizes_;   ///< size of each column value
+    std::vector<std::size_t> offsets_; ///< offset of each column block in chunk_
+    std::vector<char> chunk_;          ///< buffered chunk (header + column blocks)
+    std::size_t chunk_rows_;           ///< rows per chunk
+    std::size_t buffered_;             ///< rows buffered in chunk_
+    uint64 rows_;                      ///< rows recorded
+};
+
+//==============================================================================
+// READER
+//==============================================================================
+
+/// Reads a file written by BinaryRecorder by memory-mapping it
+class BinaryRecordingReader : public NonCopyable {
+public:
+    /// A contiguous array of column values
+    template <typename T>
+    struct Span {
+        Span(const T* data = nullptr, std::size_t size = 0) : data(data), size(size) {}
+        const T* begin() const { return data; }
+        const T* end() const { return data + size; }
+        const T& operator[](std::size_t i) const { return data[i]; }
+        bool empty() const { return size == 0; }
+        const T* data;    ///< first value
+        std::size_t size; ///< number of values
+    };
+
+    /// Default constructor
+    BinaryRecordingReader();
+
+    /// Constructor with filepath provided (opens file)
+    BinaryRecordingReader(const std::string& filepath);
+
+    /// Maps a recording and locates its chunks. A trailing chunk which was
+    /// not completely written (e.g. after a crash) is ignored.
+    bool open(const std::string& filepath);
+
+    /// Unmaps and closes the file
+    void close();
+
+    /// Returns true if the file is open
+    bool is_open() const;
+
+    /// Returns the schema
+    const std::vector<RecordColumn>& schema() const;
+
+    /// Returns the number of columns
+    std::size_t column_count() const;
+
+    /// Returns the index of the column with name (-1 if not found)
+    int find_column(const std::string& name) const;
+
+    /// Returns the number of rows
+    std::size_t row_count() const;
+
+    /// Returns the number of chunks
+    std::size_t chunk_count() const;
+
+    /// Returns the number of rows in chunk
+    std::size_t chunk_rows(std::size_t chunk) const;
+
+    /// Returns column col of chunk without copying. T must match the column
+    /// type, otherwise an empty Span is returned.
+    template <typename T>
+    Span<T> chunk_column(std::size_t chunk, std::size_t col) const;
+
+    /// Returns column col as one Span per chunk, each referencing the file
+    /// directly (no copy). T must match the column type, otherwise no Spans
+    /// are returned.
+    template <typename T>
+    std::vector<Span<T>> column_chunks(std::size_t col) const;
+
+    /// Returns column col by name as one Span per chunk (see column_chunks(col))
+    template <typename T>
+    std::vector<Span<T>> column_chunks(const std::string& name) const;
+
+    /// Returns an entire column as a contiguous Span. Only if the recording is
+    /// a single chunk and T matches the column type is the file referenced
+    /// directly. Otherwise (i.e. any recording longer than one chunk, 4096
+    /// rows by default) the column is copied (and converted to T) into
+    /// storage owned by the reader, valid until the next call or close().
+    /// Use column_chunks() to avoid the copy.
+    template <typename T>
+    Span<T> column(std::size_t col);
+
+    /// Returns an entire column by name (see column(col))
+    template <typename T>
+    Span<T> column(const std::string& name);
+
+    /// Copies a column into out, converting values to T
+    template <typename T>
+    bool read_column(std::size_t col, std::vector<T>& out) const;
+
+    /// Returns the raw bytes of column col of chunk
+    const char* chunk_data(std::size_t chunk, std::size_t col) const;
+
+private:
+    /// Checks a column index
+    bool check_column(std::size_t col) const;
+
+private:
+    detail::FileMapping mapping_;          ///< mapped file
+    std::vector<RecordColumn> schema_;     ///< column names and types
+    std::vector<const char*> chunks_;      ///< start of each chunk
+    std::vector<std::size_t> chunk_rows_;  ///< rows in each chunk
+    std::size_t row_count_;                ///< total rows
+    std::vector<char> gathered_;           ///< storage for gathered columns
+};
+
+/// Converts a recording to a CSV file with a header row of column names
+bool binary_recording_to_csv(const std::string& recording_path, const std::string& csv_path,
+                             Csv::FloatFormat format = Csv::Shortest, std::size_t precision = 6);
+
+} // namespace util
+} // namespace mahi
+
+#include <Mahi/Util/Logging/Detail/BinaryRecorder.inl>
@@ -16,9 +16,12 @@
 
 #pragma once
 
+#include <Mahi/Util/Logging/CsvReader.hpp>
+#include <Mahi/Util/Logging/CsvSchema.hpp>
 #include <Mahi/Util/Logging/File.hpp>
 #include <Mahi/Util/NonCopyable.hpp>
 #include <Mahi/Util/System.hpp>
+#include <fmt/format.h>
 #include <vector>
 #include <sstream>
 #include <fstream>
@@ -28,33 +31,80 @@
 namespace mahi {
 namespace util {
 
-/// Represents an instance of a Comma-Separated Value (CSV) file
+/// Represents an instance of a Comma-Separated Value (CSV) file. Rows are
+/// formatted into an in-memory buffer which is written to the file in large
+/// blocks (see set_buffer_size). Call flush() to force buffered rows out.
 class Csv : public File {
 public:
 
+    /// Format of floating point values
+    enum FloatFormat {
+        General,  ///< like std::ostream / printf %g with the set precision (default)
+        Fixed,    ///< fixed notation with precision digits after the decimal point
+        Shortest  ///< shortest representation which round trips exactly
+    };
+
     /// Default constructor
     Csv();
 
     /// Constructor with filepath provided (opens file)
     Csv(const std::string& filepath, WriteMode w_mode = Truncate, OpenMode o_mode = OpenOrCreate);
 
-    /// Writes a variable number of arguments to a new row, separated by commas
+    /// Destructor (writes buffered rows)
+    ~Csv();
+
+    /// Opens the file for writing, writing any rows buffered for a previous file
+    bool open(const std::string &filepath, WriteMode mode = Truncate, OpenMode o_mode = OpenOrCreate) override;
+
+    /// Writes a variable number of arguments to a new row, separated by
+    /// commas. Containers are written as one field per element.
     template <typename Arg, typename... Args>
-    void write_row(Arg&& arg, Args&&... args);
+    typename std::enable_if<!detail::is_csv_schema<typename std::decay<Arg>::type>::value>::type
+    write_row(Arg&& arg, Args&&... args);
+
+    /// Writes the column names of schema as a new row
+    template <typename... Ts>
+    void write_header(const CsvSchema<Ts...>& schema);
+
+    /// Writes a new row with the types and formatting fixed by schema
+    template <typename... Ts>
+    void write_row(const CsvSchema<Ts...>& schema, const typename detail::csv_identity<Ts>::type&... values);
 
     /// Sets the precision of floating point values (default 6)
     void set_precision(std::size_t precision);
+
+    /// Sets the format of floating point values (default General)
+    void set_float_format(FloatFormat format);
+
+    /// Sets the number of bytes buffered before writing to the file (default
+    /// 64 KiB). A size of 0 writes every row immediately.
+    void set_buffer_size(std::size_t size);
+
+    /// Writes buffered rows to the file
+    void flush();
+
+    /// Writes buffered rows and commits the file to the storage device
+    bool sync(bool data_only = false) override;
+
+    /// Writes buffered rows and closes the file
+    void close() override;
     
 private:
 
     // hide functions inherited from File
     using File::unlink;
     using File::rename;
-    using File::write;
+
+    /// Writes buffered rows, then data (only reachable through a File
+    /// reference, so that raw writes never land ahead of buffered rows)
+    int write(const void* data, std::size_t count) override;
 
 private:
 
-    std::size_t precision_;  ///< precision of floating point values
+    std::size_t precision_;     ///< precision of floating point values
+    FloatFormat float_format_;  ///< format of floating point values
+    std::size_t buffer_size_;   ///< bytes buffered before writing
+    fmt::memory_buffer buffer_; ///< formatted rows not yet written
 };
 
 // The following free functions are provided for convenience and are not
@@ -70,9 +120,14 @@ private:
 template <typename Container1D>
 bool csv_read_row(const std::string &filepath, Container1D &data_out, std::size_t row_offset, std::size_t col_offset = 0);
 
-/// Reads multiple rows into a 1D container. The container must be presized.
+/// Reads multiple rows into a 2D container. The container must be presized.
+/// Large files are parsed in parallel when threads != 1 (see
+/// CsvReader::read_rows), on pool if provided, with results identical to the
+/// serial path. Pass a pool when reading many files to avoid starting threads
+/// on every call.
 template <typename Container2D>
-bool csv_read_rows(const std::string &filepath, Container2D &data_out, std::size_t row_offset = 0, std::size_t col_offset = 0);
+bool csv_read_rows(const std::string &filepath, Container2D &data_out, std::size_t row_offset = 0, std::size_t col_offset = 0, std::size_t threads = 1,
+                   ThreadPool* pool = nullptr);
 
 /// Writes a 1D container to file
 template <typename Container1D>
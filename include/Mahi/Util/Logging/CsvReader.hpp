@@ -0,0 +1,306 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#pragma once
+
+#include <Mahi/Util/Concurrency/ThreadPool.hpp>
+#include <Mahi/Util/Logging/Detail/FileMapping.hpp>
+#include <Mahi/Util/Types.hpp>
+#include <Mahi/Util/NonCopyable.hpp>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace mahi {
+namespace util {
+
+template <typename... Ts>
+class CsvSchema;
+
+namespace detail {
+
+//==============================================================================
+// FIELD PARSING
+//==============================================================================
+
+/// Returns true for chars trimmed from the ends of a CSV field
+inline bool csv_is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+/// Parses the leading floating point number of [first, last). Falls back to
+/// strtod when the fast path can't guarantee a correctly rounded result.
+/// Returns false if no number was found.
+bool csv_parse_double(const char* first, const char* last, double& value);
+
+/// Parses an integer field. Like std::istream, parsing stops at the first
+/// invalid char, and fields without a number (or which overflow) yield 0.
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+                        !std::is_same<T, char>::value, bool>::type
+csv_parse(const char* first, const char* last, T& value) {
+    bool negative = false;
+    if (first != last && (*first == '-' || *first == '+'))
+        negative = *first++ == '-';
+    if (first == last || static_cast<unsigned>(*first - '0') > 9 || (negative && !std::is_signed<T>::value)) {
+        value = 0;
+        return false;
+    }
+    typedef typename std::make_unsigned<T>::type U;
+    const U limit = negative ? static_cast<U>(static_cast<U>(std::numeric_limits<T>::max()) + 1)
+                             : static_cast<U>(std::numeric_limits<T>::max());
+    U result = 0;
+    for (; first != last; ++first) {
+        unsigned digit = static_cast<unsigned>(*first - '0');
+        if (digit > 9)
+            break;
+        if (result > (limit - digit) / 10) {
+            value = 0;
+            return false;
+        }
+        result = static_cast<U>(result * 10 + digit);
+    }
+    value = negative ? static_cast<T>(0 - result) : static_cast<T>(result);
+    return true;
+}
+
+/// Parses a boolean field ("0"/"1", as written by std::ostream)
+inline bool csv_parse(const char* first, const char* last, bool& value) {
+    int i;
+    bool ok = csv_parse(first, last, i);
+    value = i != 0;
+    return ok;
+}
+
+/// Reads the first char of a field (as std::istream does)
+inline bool csv_parse(const char* first, const char* last, char& value) {
+    value = first != last ? *first : '\0';
+    return first != last;
+}
+
+/// Parses a floating point field
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value, bool>::type
+csv_parse(const char* first, const char* last, T& value) {
+    double d;
+    bool ok = csv_parse_double(first, last, d);
+    value = ok ? static_cast<T>(d) : T(0);
+    return ok;
+}
+
+/// Copies a string field
+inline bool csv_parse(const char* first, const char* last, std::string& value) {
+    value.assign(first, last);
+    return true;
+}
+
+/// Parses any other type with operator>>
+template <typename T>
+typename std::enable_if<!std::is_arithmetic<T>::value, bool>::type
+csv_parse(const char* first, const char* last, T& value) {
+    std::istringstream ss(std::string(first, last));
+    ss >> value;
+    return !ss.fail();
+}
+
+} // namespace detail
+
+//==============================================================================
+// CSV READER
+//==============================================================================
+
+/// Fast, read-only access to a CSV file. The file is memory mapped, lines and
+/// fields are found with memchr (which the C library vectorizes), and fields
+/// are parsed in place without copying. Numeric fields use allocation-free
+/// parsers; other types fall back to operator>>. Quoted fields are not
+/// interpreted, matching the rest of the Csv module.
+///
+/// Finding a row requires scanning the lines before it. build_index() makes
+/// a single pass recording the offset of every stride-th row, after which
+/// any row is found by scanning fewer than stride lines. The index can be
+/// saved next to the file and loaded by later readers.
+class CsvReader : NonCopyable {
+public:
+
+    /// Forward cursor which reads a file in batches of rows. Only the pages
+    /// being parsed need to be resident, so files larger than memory can be
+    /// processed in constant memory.
+    class Cursor {
+    public:
+        /// Constructs a cursor at row of reader
+        Cursor(const CsvReader& reader, std::size_t row = 0, std::size_t col_offset = 0);
+
+        /// Reads the next data_out.size() rows into a presized 2D container.
+        /// Returns the number of rows read, which is 0 once all rows are read.
+        template <typename Container2D>
+        std::size_t next(Container2D& data_out);
+
+        /// Moves the cursor to row
+        void seek(std::size_t row);
+
+        /// Returns the index of the next row to be read
+        std::size_t row() const { return row_; }
+
+        /// Returns true if all rows have been read
+        bool done() const { return p_ == reader_->end_; }
+
+    private:
+        const CsvReader* reader_; ///< reader being iterated
+        const char* p_;           ///< start of next row
+        std::size_t row_;         ///< index of next row
+        std::size_t col_offset_;  ///< first column read
+    };
+
+    /// Default constructor
+    CsvReader();
+
+    /// Constructor with filepath provided (opens file)
+    CsvReader(const std::string& filepath, char delimiter = ',');
+
+    /// Default destructor (closes file if open)
+    ~CsvReader();
+
+    /// Opens and maps the file
+    bool open(const std::string& filepath, char delimiter = ',');
+
+    /// Unmaps and closes the file
+    void close();
+
+    /// Returns true if file is open
+    bool is_open() const;
+
+    /// Returns the contents of the file
+    const char* data() const { return begin_; }
+
+    /// Returns the size of the file in bytes
+    std::size_t size() const { return static_cast<std::size_t>(end_ - begin_); }
+
+    /// Counts the rows in the file (constant time once indexed)
+    std::size_t row_count() const;
+
+    /// Returns a Cursor positioned at row
+    Cursor cursor(std::size_t row = 0, std::size_t col_offset = 0) const { return Cursor(*this, row, col_offset); }
+
+    /// Scans the file once, recording the offset of every stride-th row
+    void build_index(std::size_t stride = 1024);
+
+    /// Returns true if the row index has been built or loaded
+    bool is_indexed() const { return !index_.empty(); }
+
+    /// Saves the row index (default path is the file path + ".idx")
+    bool save_index(const std::string& index_path = "") const;
+
+    /// Loads a row index saved for this file. Fails if the file has been
+    /// modified since the index was saved.
+    bool load_index(const std::string& index_path = "");
+
+    /// Reads a single row into a presized 1D container. Returns false if the row does not exist.
+    template <typename Container1D>
+    bool read_row(Container1D& data_out, std::size_t row_offset, std::size_t col_offset = 0) const;
+
+    /// Reads rows into a presized 2D container. Returns the number of rows
+    /// read. With threads > 1, large files are split into byte ranges on line
+    /// boundaries which are parsed in parallel straight into their rows, with
+    /// results identical to the serial path. The ranges are parsed on pool, or
+    /// on a temporary ThreadPool if pool is nullptr. A value of 0 uses the
+    /// size of pool, or else the number of hardware threads.
+    template <typename Container2D>
+    std::size_t read_rows(Container2D& data_out, std::size_t row_offset = 0, std::size_t col_offset = 0, std::size_t threads = 1,
+                          ThreadPool* pool = nullptr) const;
+
+    /// Reads column col of every row from row_offset on into a vector. Rows
+    /// without the column contribute T(). Returns the number of values read.
+    template <typename T>
+    std::size_t read_column(std::vector<T>& column_out, std::size_t col, std::size_t row_offset = 0) const;
+
+    /// Reads columns [col_offset, col_offset + columns_out.size()) into a set of vectors
+    template <typename T>
+    std::size_t read_columns(std::vector<std::vector<T>>& columns_out, std::size_t row_offset = 0, std::size_t col_offset = 0) const;
+
+    /// Parses row into a tuple typed by schema. Returns false if the row does
+    /// not exist or a field is missing or invalid.
+    template <typename... Ts>
+    bool read_row(const CsvSchema<Ts...>& schema, std::tuple<Ts...>& row_out, std::size_t row_offset) const;
+
+    /// Parses every row from row_offset on (by default skipping the header)
+    /// into tuples typed by schema. Missing or invalid fields are left
+    /// default constructed. Returns the number of rows read.
+    template <typename... Ts>
+    std::size_t read_rows(const CsvSchema<Ts...>& schema, std::vector<std::tuple<Ts...>>& rows_out, std::size_t row_offset = 1) const;
+
+private:
+
+    /// Returns the start of row, or end_ if the file has fewer rows
+    const char* seek_row(std::size_t row) const;
+
+    /// Returns the start of the next line after the line starting at p
+    const char* next_line(const char* p) const {
+        const char* eol = line_end(p);
+        return eol == end_ ? end_ : eol + 1;
+    }
+
+    /// Returns the end of the line starting at p (the '\n' or end_)
+    const char* line_end(const char* p) const {
+        const char* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end_ - p)));
+        return nl ? nl : end_;
+    }
+
+    /// Parses the fields of line [p, eol) from col_offset on into out[0..n)
+    template <typename Container1D>
+    void parse_line(const char* p, const char* eol, Container1D& out, std::size_t n, std::size_t col_offset) const;
+
+    /// Splits [p, end_) into at most parts ranges which start on lines,
+    /// returning the range bounds (fewer ranges are used for small files)
+    std::vector<const char*> split_lines(const char* p, std::size_t parts) const;
+
+    /// Counts the lines starting in [first, last)
+    std::size_t count_lines(const char* first, const char* last) const;
+
+    /// Finds the bounds of field col in line [p, eol), returning false if it doesn't exist
+    bool find_field(const char* p, const char* eol, std::size_t col, const char*& first, const char*& last) const;
+
+    /// Parses field [first, last), trimming whitespace
+    template <typename T>
+    static void parse_field(const char* first, const char* last, T& value) {
+        while (first != last && detail::csv_is_space(*first))
+            ++first;
+        while (last != first && detail::csv_is_space(*(last - 1)))
+            --last;
+        detail::csv_parse(first, last, value);
+    }
+
+private:
+
+    detail::FileMapping mapping_; ///< mapped file
+    std::string filepath_;      ///< path of the open file
+    const char* begin_;         ///< mapped contents
+    const char* end_;           ///< end of mapped contents
+    char delimiter_;            ///< field delimiter
+    std::vector<uint64> index_; ///< offset of every index_stride_-th row
+    std::size_t index_stride_;  ///< rows between index entries
+    std::size_t row_count_;     ///< rows in the file (valid if indexed)
+};
+
+} // namespace util
+} // namespace mahi
+
+#include <Mahi/Util/Logging/Detail/CsvReader.inl>
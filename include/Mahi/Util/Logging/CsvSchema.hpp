@@ -0,0 +1,273 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#pragma once
+
+#include <Mahi/Util/Logging/CsvReader.hpp>
+#include <Mahi/Util/Types.hpp>
+#include <fmt/format.h>
+#include <array>
+#include <cmath>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+namespace mahi {
+namespace util {
+
+namespace detail {
+
+//==============================================================================
+// TYPED FIELDS
+//==============================================================================
+
+/// Writes value in fixed notation with precision digits after the point,
+/// matching Csv::Fixed. Values which fit in 53 bits once scaled are rounded
+/// and printed as two integers. Others, and values so close to a rounding
+/// tie that the scaling error could matter, fall back to fmt.
+inline void csv_write_fixed(fmt::memory_buffer& buf, double value, int precision) {
+    static const uint64 POW10[] = {1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull,
+                                   10000000ull, 100000000ull, 1000000000ull, 10000000000ull,
+                                   100000000000ull, 1000000000000ull, 10000000000000ull,
+                                   100000000000000ull, 1000000000000000ull};
+    if (precision >= 0 && precision <= 15) {
+        const double scaled = std::fabs(value) * static_cast<double>(POW10[precision]);
+        const double tie    = scaled - std::floor(scaled) - 0.5;
+        // scaling rounds by at most half an ulp (< scaled * 2^-53)
+        if (scaled < 9007199254740992.0 && std::fabs(tie) > scaled * 2.3e-16) {  // 2^53, also false for nan
+            const uint64 n = static_cast<uint64>(tie > 0 ? std::ceil(scaled) : std::floor(scaled));
+            if (std::signbit(value))
+                buf.push_back('-');
+            fmt::format_int whole(n / POW10[precision]);
+            buf.append(whole.data(), whole.data() + whole.size());
+            if (precision > 0) {
+                char frac[16];
+                uint64 f = n % POW10[precision];
+                for (int i = precision - 1; i >= 0; --i, f /= 10)
+                    frac[i] = static_cast<char>('0' + f % 10);
+                buf.push_back('.');
+                buf.append(frac, frac + precision);
+            }
+            return;
+        }
+    }
+    fmt::format_to(buf, "{:.{}f}", value, precision);
+}
+
+/// Field categories of a CsvSchema column, used to pick a formatter
+template <int N> struct csv_schema_tag {};
+
+template <typename T>
+struct csv_schema_kind {
+    static const int value =
+        std::is_enum<T>::value ? 0 :
+        std::is_same<T, bool>::value ? 1 :
+        std::is_same<T, char>::value ? 2 :
+        std::is_integral<T>::value ? 3 :
+        std::is_floating_point<T>::value ? 4 :
+        std::is_same<T, std::string>::value ? 5 : -1;
+};
+
+template <typename T>
+inline void csv_format_typed(fmt::memory_buffer& buf, const T& value, int, csv_schema_tag<0>) {
+    fmt::format_int formatted(static_cast<typename std::underlying_type<T>::type>(value));
+    buf.append(formatted.data(), formatted.data() + formatted.size());
+}
+
+inline void csv_format_typed(fmt::memory_buffer& buf, bool value, int, csv_schema_tag<1>) {
+    buf.push_back(value ? '1' : '0');
+}
+
+inline void csv_format_typed(fmt::memory_buffer& buf, char value, int, csv_schema_tag<2>) {
+    buf.push_back(value);
+}
+
+template <typename T>
+inline void csv_format_typed(fmt::memory_buffer& buf, T value, int, csv_schema_tag<3>) {
+    fmt::format_int formatted(value);
+    buf.append(formatted.data(), formatted.data() + formatted.size());
+}
+
+template <typename T>
+inline void csv_format_typed(fmt::memory_buffer& buf, T value, int precision, csv_schema_tag<4>) {
+    csv_write_fixed(buf, static_cast<double>(value), precision);
+}
+
+inline void csv_format_typed(fmt::memory_buffer& buf, const std::string& value, int, csv_schema_tag<5>) {
+    buf.append(value.data(), value.data() + value.size());
+}
+
+/// Writes a CsvSchema field
+template <typename T>
+inline void csv_format_typed(fmt::memory_buffer& buf, const T& value, int precision) {
+    static_assert(csv_schema_kind<T>::value >= 0, "Unsupported CsvSchema column type");
+    csv_format_typed(buf, value, precision, csv_schema_tag<csv_schema_kind<T>::value>());
+}
+
+/// Parses an enum field as its underlying integer
+template <typename T>
+inline typename std::enable_if<std::is_enum<T>::value, bool>::type
+csv_parse_typed(const char* first, const char* last, T& value) {
+    typedef typename std::conditional<std::is_signed<typename std::underlying_type<T>::type>::value,
+                                      long long, unsigned long long>::type Integer;
+    Integer i;
+    bool ok = csv_parse(first, last, i);
+    value = static_cast<T>(i);
+    return ok;
+}
+
+/// Parses any other CsvSchema field
+template <typename T>
+inline typename std::enable_if<!std::is_enum<T>::value, bool>::type
+csv_parse_typed(const char* first, const char* last, T& value) {
+    return csv_parse(first, last, value);
+}
+
+/// Prevents deduction of T (so values convert to the column types)
+template <typename T>
+struct csv_identity { typedef T type; };
+
+/// Formats and parses fields [I, N) of a row tuple
+template <std::size_t I, std::size_t N>
+struct CsvSchemaFields {
+    template <typename Tuple>
+    static void format(fmt::memory_buffer& buf, const Tuple& row, const int* precision) {
+        if (I > 0)
+            buf.push_back(',');
+        csv_format_typed(buf, std::get<I>(row), precision[I]);
+        CsvSchemaFields<I + 1, N>::format(buf, row, precision);
+    }
+
+    template <typename Tuple>
+    static bool parse(const char* p, const char* eol, char delimiter, Tuple& row) {
+        const char* delim = static_cast<const char*>(std::memchr(p, delimiter, static_cast<std::size_t>(eol - p)));
+        const char* first = p;
+        const char* last  = delim ? delim : eol;
+        while (first != last && csv_is_space(*first))
+            ++first;
+        while (last != first && csv_is_space(*(last - 1)))
+            --last;
+        bool ok = csv_parse_typed(first, last, std::get<I>(row));
+        if (!delim)
+            return ok && I + 1 == N;
+        return CsvSchemaFields<I + 1, N>::parse(delim + 1, eol, delimiter, row) && ok;
+    }
+};
+
+template <std::size_t N>
+struct CsvSchemaFields<N, N> {
+    template <typename Tuple>
+    static void format(fmt::memory_buffer&, const Tuple&, const int*) {}
+
+    template <typename Tuple>
+    static bool parse(const char*, const char*, char, Tuple&) { return true; }
+};
+
+} // namespace detail
+
+//==============================================================================
+// CSV SCHEMA
+//==============================================================================
+
+/// Fixes the names and types of the columns of a CSV file at compile time.
+/// Each column gets a formatter specialized for its type (integers, bools,
+/// enums as their underlying integer, floating point in fixed notation with
+/// a per-column precision, and strings), so formatting a row involves no
+/// stream state, format string parsing or runtime type dispatch. The same
+/// schema parses rows back into tuples with CsvReader.
+///
+///     CsvSchema<double, int, Mode> schema({"time", "count", "mode"});
+///     csv.write_header(schema);
+///     csv.write_row(schema, t, n, mode);
+///     ...
+///     std::vector<CsvSchema<double, int, Mode>::Row> rows;
+///     reader.read_rows(schema, rows);
+template <typename... Ts>
+class CsvSchema {
+public:
+    static_assert(sizeof...(Ts) > 0, "CsvSchema requires at least one column");
+
+    /// Tuple holding one row
+    typedef std::tuple<Ts...> Row;
+
+    /// Array of column names
+    typedef std::array<std::string, sizeof...(Ts)> Names;
+
+    /// Constructor with column names and the precision of floating point columns
+    explicit CsvSchema(const Names& names, int precision = 6) : names_(names) {
+        precision_.fill(precision);
+    }
+
+    /// Returns the number of columns
+    static constexpr std::size_t size() { return sizeof...(Ts); }
+
+    /// Returns the column names
+    const Names& names() const { return names_; }
+
+    /// Sets the precision of all floating point columns
+    void set_precision(int precision) { precision_.fill(precision); }
+
+    /// Sets the precision of floating point column col
+    void set_precision(std::size_t col, int precision) { precision_[col] = precision; }
+
+    /// Returns the precision of column col
+    int get_precision(std::size_t col) const { return precision_[col]; }
+
+    /// Appends the header row (without line ending) to buf
+    void format_header(fmt::memory_buffer& buf) const {
+        for (std::size_t j = 0; j < names_.size(); ++j) {
+            if (j > 0)
+                buf.push_back(',');
+            buf.append(names_[j].data(), names_[j].data() + names_[j].size());
+        }
+    }
+
+    /// Appends a row (without line ending) to buf
+    void format_row(fmt::memory_buffer& buf, const Ts&... values) const {
+        format_tuple(buf, std::forward_as_tuple(values...));
+    }
+
+    /// Appends a row tuple (without line ending) to buf
+    template <typename Tuple>
+    void format_tuple(fmt::memory_buffer& buf, const Tuple& row) const {
+        detail::CsvSchemaFields<0, sizeof...(Ts)>::format(buf, row, precision_.data());
+    }
+
+    /// Parses line [first, last) into row. Returns false if a field is
+    /// missing or invalid.
+    bool parse_row(const char* first, const char* last, Row& row, char delimiter = ',') const {
+        row = Row();
+        return detail::CsvSchemaFields<0, sizeof...(Ts)>::parse(first, last, delimiter, row);
+    }
+
+private:
+    Names names_;                                  ///< column names
+    std::array<int, sizeof...(Ts)> precision_;     ///< precision of each column
+};
+
+namespace detail {
+
+/// Detects CsvSchema types
+template <typename T>
+struct is_csv_schema : std::false_type {};
+
+template <typename... Ts>
+struct is_csv_schema<CsvSchema<Ts...>> : std::true_type {};
+
+} // namespace detail
+
+} // namespace util
+} // namespace mahi
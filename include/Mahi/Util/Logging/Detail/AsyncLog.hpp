@@ -0,0 +1,90 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#pragma once
+
+#include <Mahi/Util/Logging/Detail/LogUtil.hpp>
+#include <Mahi/Util/Timing/Time.hpp>
+#include <cstring>
+
+/// Maximum message length (in chars) carried by a queued asynchronous record.
+/// Longer messages are truncated.
+#ifndef MAHI_LOG_QUEUED_MESSAGE_SIZE
+#define MAHI_LOG_QUEUED_MESSAGE_SIZE MAHI_LOG_RECORD_SIZE
+#endif
+
+namespace mahi {
+namespace util {
+
+/// Configures the asynchronous mode of a Logger (see Logger::enable_async)
+struct AsyncLogOptions {
+    /// Policy applied when a record is logged while the queue is full
+    enum Overflow {
+        Block,       ///< the logging thread yields until space is available
+        DropNewest,  ///< the new record is discarded
+        DropOldest   ///< the oldest queued record is discarded to make room
+    };
+
+    /// Constructor
+    AsyncLogOptions(std::size_t capacity    = 4096,
+                    Overflow    overflow    = DropNewest,
+                    Time        poll_period = milliseconds(1)) :
+        capacity(capacity),
+        overflow(overflow),
+        poll_period(poll_period) {}
+
+    std::size_t capacity;  ///< maximum number of records waiting in the queue
+    Overflow overflow;     ///< what to do when the queue is full
+    Time poll_period;      ///< how long the background thread sleeps when idle
+};
+
+namespace detail {
+
+/// Fixed size copy of a LogRecord which can be placed in a lock-free queue
+/// without allocating
+struct QueuedLogRecord {
+    QueuedLogRecord() : severity(None), tid(0), line(0), func(""), file(""), size(0) {
+        message[0] = '\0';
+    }
+
+    explicit QueuedLogRecord(const LogRecord& record) :
+        timestamp(record.get_timestamp()),
+        severity(record.get_severity()),
+        tid(record.get_tid_()),
+        line(record.get_line()),
+        func(record.get_func_signature()),
+        file(record.get_file())
+    {
+        size = record.get_message_size();
+        if (size >= MAHI_LOG_QUEUED_MESSAGE_SIZE)
+            size = MAHI_LOG_QUEUED_MESSAGE_SIZE - 1;
+        std::memcpy(message, record.get_message(), size);
+        message[size] = '\0';
+    }
+
+    Timestamp    timestamp;
+    Severity     severity;
+    unsigned int tid;
+    size_t       line;
+    const char*  func;
+    const char*  file;
+    size_t       size;
+    char         message[MAHI_LOG_QUEUED_MESSAGE_SIZE];
+};
+
+} // namespace detail
+} // namespace util
+} // namespace mahi
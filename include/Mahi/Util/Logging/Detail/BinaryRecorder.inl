@@ -0,0 +1,139 @@
+namespace mahi {
+namespace util {
+
+namespace detail {
+
+template <typename S, typename T>
+inline void record_store_as(char* dst, T value) {
+    S stored = static_cast<S>(value);
+    std::memcpy(dst, &stored, sizeof(S));
+}
+
+template <typename T>
+inline void record_store(char* dst, RecordType type, T value) {
+    switch (type) {
+        case RecordInt8:    record_store_as<signed char>(dst, value);   break;
+        case RecordInt16:   record_store_as<int16>(dst, value);  break;
+        case RecordInt32:   record_store_as<int32>(dst, value);  break;
+        case RecordInt64:   record_store_as<int64>(dst, value);  break;
+        case RecordUInt8:   record_store_as<uint8>(dst, value);  break;
+        case RecordUInt16:  record_store_as<uint16>(dst, value); break;
+        case RecordUInt32:  record_store_as<uint32>(dst, value); break;
+        case RecordUInt64:  record_store_as<uint64>(dst, value); break;
+        case RecordFloat32: record_store_as<float>(dst, value);  break;
+        case RecordFloat64: record_store_as<double>(dst, value); break;
+    }
+}
+
+template <typename S, typename T>
+inline void record_load_as(const char* src, std::size_t n, T* out) {
+    for (std::size_t i = 0; i < n; ++i) {
+        S stored;
+        std::memcpy(&stored, src + i * sizeof(S), sizeof(S));
+        out[i] = static_cast<T>(stored);
+    }
+}
+
+template <typename T>
+inline void record_load(const char* src, RecordType type, std::size_t n, T* out) {
+    switch (type) {
+        case RecordInt8:    record_load_as<signed char>(src, n, out);   break;
+        case RecordInt16:   record_load_as<int16>(src, n, out);  break;
+        case RecordInt32:   record_load_as<int32>(src, n, out);  break;
+        case RecordInt64:   record_load_as<int64>(src, n, out);  break;
+        case RecordUInt8:   record_load_as<uint8>(src, n, out);  break;
+        case RecordUInt16:  record_load_as<uint16>(src, n, out); break;
+        case RecordUInt32:  record_load_as<uint32>(src, n, out); break;
+        case RecordUInt64:  record_load_as<uint64>(src, n, out); break;
+        case RecordFloat32: record_load_as<float>(src, n, out);  break;
+        case RecordFloat64: record_load_as<double>(src, n, out); break;
+    }
+}
+
+} // namespace detail
+
+template <typename T>
+void BinaryRecorder::store(std::size_t col, T value) {
+    static_assert(std::is_arithmetic<T>::value, "BinaryRecorder values must be arithmetic types");
+    detail::record_store(&chunk_[offsets_[col] + buffered_ * sizes_[col]], schema_[col].type, value);
+}
+
+template <typename... Args>
+bool BinaryRecorder::record(const Args&... values) {
+    if (!check_row(sizeof...(Args)))
+        return false;
+    std::size_t col = 0;
+    using expander = int[];
+    (void)expander{0, (store(col++, values), 0)...};
+    return commit_row();
+}
+
+template <typename Container1D>
+bool BinaryRecorder::record_row(const Container1D& values) {
+    if (!check_row(values.size()))
+        return false;
+    for (std::size_t j = 0; j < schema_.size(); ++j)
+        store(j, values[j]);
+    return commit_row();
+}
+
+template <typename T>
+BinaryRecordingReader::Span<T> BinaryRecordingReader::chunk_column(std::size_t chunk, std::size_t col) const {
+    if (chunk >= chunks_.size() || !check_column(col) || schema_[col].type != record_type<T>())
+        return Span<T>();
+    return Span<T>(reinterpret_cast<const T*>(chunk_data(chunk, col)), chunk_rows_[chunk]);
+}
+
+template <typename T>
+std::vector<BinaryRecordingReader::Span<T>> BinaryRecordingReader::column_chunks(std::size_t col) const {
+    std::vector<Span<T>> spans;
+    if (!check_column(col) || schema_[col].type != record_type<T>())
+        return spans;
+    spans.reserve(chunks_.size());
+    for (std::size_t c = 0; c < chunks_.size(); ++c)
+        spans.push_back(chunk_column<T>(c, col));
+    return spans;
+}
+
+template <typename T>
+std::vector<BinaryRecordingReader::Span<T>> BinaryRecordingReader::column_chunks(const std::string& name) const {
+    int col = find_column(name);
+    return col < 0 ? std::vector<Span<T>>() : column_chunks<T>(static_cast<std::size_t>(col));
+}
+
+template <typename T>
+BinaryRecordingReader::Span<T> BinaryRecordingReader::column(std::size_t col) {
+    if (!check_column(col))
+        return Span<T>();
+    if (chunks_.size() == 1 && schema_[col].type == record_type<T>())
+        return chunk_column<T>(0, col);
+    gathered_.resize(row_count_ * sizeof(T));
+    T* out = reinterpret_cast<T*>(gathered_.data());
+    for (std::size_t c = 0; c < chunks_.size(); ++c) {
+        detail::record_load(chunk_data(c, col), schema_[col].type, chunk_rows_[c], out);
+        out += chunk_rows_[c];
+    }
+    return Span<T>(reinterpret_cast<const T*>(gathered_.data()), row_count_);
+}
+
+template <typename T>
+BinaryRecordingReader::Span<T> BinaryRecordingReader::column(const std::string& name) {
+    int col = find_column(name);
+    return col < 0 ? Span<T>() : column<T>(static_cast<std::size_t>(col));
+}
+
+template <typename T>
+bool BinaryRecordingReader::read_column(std::size_t col, std::vector<T>& out) const {
+    if (!check_column(col))
+        return false;
+    out.resize(row_count_);
+    std::size_t row = 0;
+    for (std::size_t c = 0; c < chunks_.size(); ++c) {
+        detail::record_load(chunk_data(c, col), schema_[col].type, chunk_rows_[c], out.data() + row);
+        row += chunk_rows_[c];
+    }
+    return true;
+}
+
+} // namespace util
+} // namespace mahi
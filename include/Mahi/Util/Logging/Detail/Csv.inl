@@ -1,85 +1,185 @@
 namespace mahi {
 namespace util {
 
-template <typename Arg, typename... Args>
-void Csv::write_row(Arg&& arg, Args&&... args) {
+namespace detail {
+
+/// How floating point fields are formatted
+struct CsvFormat {
+    CsvFormat(Csv::FloatFormat format = Csv::General, int precision = 6) :
+        format(format), precision(precision) {}
+    Csv::FloatFormat format;
+    int precision;
+};
+
+/// Detects types which can be iterated (other than strings)
+template <typename T>
+class csv_is_container {
+    template <typename U>
+    static char test(typename U::const_iterator*);
+    template <typename U>
+    static long test(...);
+public:
+    static const bool value = sizeof(test<T>(nullptr)) == 1 && !std::is_same<T, std::string>::value;
+};
+
+/// Field categories, used to pick a formatter
+template <int N> struct csv_tag {};
+
+template <typename T>
+struct csv_kind {
+    static const int value =
+        std::is_same<T, bool>::value ? 1 :
+        (std::is_same<T, char>::value || std::is_same<T, signed char>::value ||
+         std::is_same<T, unsigned char>::value) ? 2 :
+        std::is_integral<T>::value ? 3 :
+        std::is_floating_point<T>::value ? 4 :
+        (std::is_same<T, std::string>::value || std::is_same<T, const char*>::value ||
+         std::is_same<T, char*>::value) ? 5 :
+        csv_is_container<T>::value ? 6 : 0;
+};
+
+template <typename T>
+inline void csv_write_field(fmt::memory_buffer& buf, const T& value, const CsvFormat& format);
+
+/// Any other type is formatted with operator<<
+template <typename T>
+inline void csv_write_field(fmt::memory_buffer& buf, const T& value, const CsvFormat& format, csv_tag<0>) {
     std::ostringstream ss;
-    ss << std::setprecision(precision_);
-    ss << std::forward<Arg>(arg);
+    ss << std::setprecision(format.precision) << value;
+    std::string str = ss.str();
+    buf.append(str.data(), str.data() + str.size());
+}
+
+inline void csv_write_field(fmt::memory_buffer& buf, bool value, const CsvFormat&, csv_tag<1>) {
+    buf.push_back(value ? '1' : '0');
+}
+
+/// char, signed char and unsigned char (int8/uint8) are written as characters,
+/// like std::ostream
+template <typename T>
+inline void csv_write_field(fmt::memory_buffer& buf, T value, const CsvFormat&, csv_tag<2>) {
+    buf.push_back(static_cast<char>(value));
+}
+
+template <typename T>
+inline void csv_write_field(fmt::memory_buffer& buf, T value, const CsvFormat&, csv_tag<3>) {
+    fmt::format_int formatted(value);
+    buf.append(formatted.data(), formatted.data() + formatted.size());
+}
+
+template <typename T>
+inline void csv_write_field(fmt::memory_buffer& buf, T value, const CsvFormat& format, csv_tag<4>) {
+    switch (format.format) {
+        case Csv::Fixed:
+            fmt::format_to(buf, "{:.{}f}", value, format.precision);
+            break;
+        case Csv::Shortest:
+            fmt::format_to(buf, "{}", value);
+            break;
+        default:
+            // precision 0 means 1 for %g, as in std::ostream
+            fmt::format_to(buf, "{:.{}g}", value, format.precision > 0 ? format.precision : 1);
+            break;
+    }
+}
+
+inline void csv_write_field(fmt::memory_buffer& buf, const std::string& value, const CsvFormat&, csv_tag<5>) {
+    buf.append(value.data(), value.data() + value.size());
+}
+
+inline void csv_write_field(fmt::memory_buffer& buf, const char* value, const CsvFormat&, csv_tag<5>) {
+    buf.append(value, value + std::strlen(value));
+}
+
+/// Containers are written as one field per element
+template <typename T>
+inline void csv_write_field(fmt::memory_buffer& buf, const T& value, const CsvFormat& format, csv_tag<6>) {
+    bool first = true;
+    for (typename T::const_iterator it = value.begin(); it != value.end(); ++it) {
+        if (!first)
+            buf.push_back(',');
+        csv_write_field(buf, *it, format);
+        first = false;
+    }
+}
+
+template <typename T>
+inline void csv_write_field(fmt::memory_buffer& buf, const T& value, const CsvFormat& format) {
+    csv_write_field(buf, value, format, csv_tag<csv_kind<typename std::decay<T>::type>::value>());
+}
+
+/// Writes a row of a 1D container (which must support size() and operator[])
+template <typename Container1D>
+inline void csv_write_container_row(fmt::memory_buffer& buf, const Container1D& data, const CsvFormat& format) {
+    for (std::size_t j = 0; j < data.size(); ++j) {
+        if (j > 0)
+            buf.push_back(',');
+        csv_write_field(buf, data[j], format);
+    }
+    buf.push_back('\r');
+    buf.push_back('\n');
+}
+
+/// Writes a 2D container to a File in large blocks
+template <typename Container2D>
+inline void csv_write_container_rows(File& file, const Container2D& data) {
+    fmt::memory_buffer buf;
+    CsvFormat format;
+    for (std::size_t i = 0; i < data.size(); i++) {
+        csv_write_container_row(buf, data[i], format);
+        if (buf.size() >= 65536) {
+            file.write(buf.data(), buf.size());
+            buf.clear();
+        }
+    }
+    file.write(buf.data(), buf.size());
+}
+
+} // namespace detail
+
+template <typename Arg, typename... Args>
+typename std::enable_if<!detail::is_csv_schema<typename std::decay<Arg>::type>::value>::type
+Csv::write_row(Arg&& arg, Args&&... args) {
+    detail::CsvFormat format(float_format_, static_cast<int>(precision_));
+    detail::csv_write_field(buffer_, arg, format);
     using expander = int[];
-    (void)expander{0, (void(ss << ',' << std::forward<Args>(args)), 0)...};
-    ss << "\n";
-    write(ss.str());
+    (void)expander{0, (buffer_.push_back(','), detail::csv_write_field(buffer_, args, format), 0)...};
+    buffer_.push_back('\n');
+    if (buffer_.size() >= buffer_size_)
+        flush();
+}
+
+template <typename... Ts>
+void Csv::write_header(const CsvSchema<Ts...>& schema) {
+    schema.format_header(buffer_);
+    buffer_.push_back('\n');
+    if (buffer_.size() >= buffer_size_)
+        flush();
+}
+
+template <typename... Ts>
+void Csv::write_row(const CsvSchema<Ts...>& schema, const typename detail::csv_identity<Ts>::type&... values) {
+    schema.format_row(buffer_, values...);
+    buffer_.push_back('\n');
+    if (buffer_.size() >= buffer_size_)
+        flush();
 }
 
 template <typename Container1D>
 bool csv_read_row(const std::string& filepath, Container1D& data_out, std::size_t row_offset, std::size_t col_offset) {
-    std::string directory, filename, ext, full;
-    if (!parse_filepath(filepath, directory, filename, ext, full))
-        return false;
-    std::ifstream file(full);
-    file.precision(6);
-    if (!file.is_open())
+    CsvReader reader(filepath);
+    if (!reader.is_open())
         return false;
-    std::string line_string;
-    std::size_t row_r_idx = 0;
-    while (std::getline(file, line_string)) {
-        if (row_r_idx++ == row_offset) {
-            std::istringstream line_stream(line_string);
-            std::string value_string;
-            std::size_t col_r_idx = 0;
-            std::size_t col_w_idx = 0;
-            while (std::getline(line_stream, value_string, ',')) {
-                if (col_r_idx++ < col_offset)
-                    continue;
-                if (col_w_idx == data_out.size())
-                    break;
-                std::istringstream value_stream(value_string);
-                value_stream >> data_out[col_w_idx];
-                col_w_idx++;
-            }
-            break;
-        }
-    }
+    reader.read_row(data_out, row_offset, col_offset);
     return true;
 }
 
 template <typename Container2D>
-bool csv_read_rows(const std::string& filepath, Container2D& data_out, std::size_t row_offset, std::size_t col_offset) {
-    std::string directory, filename, ext, full;
-    if (!parse_filepath(filepath, directory, filename, ext, full))
-        return false;
-    std::ifstream file(full);
-    file.precision(6);
-    if (!file.is_open())
+bool csv_read_rows(const std::string& filepath, Container2D& data_out, std::size_t row_offset, std::size_t col_offset, std::size_t threads, ThreadPool* pool) {
+    CsvReader reader(filepath);
+    if (!reader.is_open())
         return false;
-    std::string line_string;
-    std::size_t row_r_idx = 0;
-    std::size_t row_w_idx = 0;
-    while (std::getline(file, line_string))
-    {
-        if (row_r_idx++ < row_offset)
-            continue;
-        if (row_w_idx == data_out.size())
-            break;
-        else {
-            std::istringstream line_stream(line_string);
-            std::string value_string;
-            std::size_t col_r_idx = 0;
-            std::size_t col_w_idx = 0;
-            while (std::getline(line_stream, value_string, ','))
-            {
-                if (col_r_idx++ < col_offset)
-                    continue;
-                if (col_w_idx == data_out[row_w_idx].size())
-                    break;
-                std::istringstream value_stream(value_string);
-                value_stream >> data_out[row_w_idx][col_w_idx];
-                col_w_idx++;
-            }
-            row_w_idx++;
-        }
-    }
+    reader.read_rows(data_out, row_offset, col_offset, threads, pool);
     return true;
 }
 
@@ -87,12 +187,9 @@ template <typename Container1D>
 bool csv_write_row(const std::string &filepath, const Container1D &data)
 {
     File file(filepath, WriteMode::Truncate);
-    std::ostringstream ss;
-    ss << std::setprecision(6);
-    for (size_t j = 0; j < data.size() - 1; ++j)
-        ss << data[j] << ",";
-    ss << data[data.size() - 1] << "\r\n";
-    file.write(ss.str());
+    fmt::memory_buffer buf;
+    detail::csv_write_container_row(buf, data, detail::CsvFormat());
+    file.write(buf.data(), buf.size());
     file.close();
     return true;
 }
@@ -101,15 +198,7 @@ template <typename Container2D>
 bool csv_write_rows(const std::string &filepath, const Container2D &data)
 {
     File file(filepath, WriteMode::Truncate);
-    for (std::size_t i = 0; i < data.size(); i++)
-    {
-        std::ostringstream ss;
-        ss << std::setprecision(6);
-        for (size_t j = 0; j < data[i].size() - 1; ++j)
-            ss << data[i][j] << ",";
-        ss << data[i][data[i].size() - 1] << "\r\n";
-        file.write(ss.str());
-    }
+    detail::csv_write_container_rows(file, data);
     file.close();
     return true;
 }
@@ -118,12 +207,9 @@ template <typename Container1D>
 bool csv_append_row(const std::string &filepath, const Container1D &data)
 {
     File file(filepath, WriteMode::Append);
-    std::ostringstream ss;
-    ss << std::setprecision(6);
-    for (size_t j = 0; j < data.size() - 1; ++j)
-        ss << data[j] << ",";
-    ss << data[data.size() - 1] << "\r\n";
-    file.write(ss.str());
+    fmt::memory_buffer buf;
+    detail::csv_write_container_row(buf, data, detail::CsvFormat());
+    file.write(buf.data(), buf.size());
     file.close();
     return true;
 }
@@ -132,17 +218,7 @@ template <typename Container2D>
 bool csv_append_rows(const std::string &filepath, const Container2D &data)
 {
     File file(filepath, WriteMode::Append);
-    for (std::size_t i = 0; i < data.size(); i++)
-    {
-        std::ostringstream ss;
-        ss << std::setprecision(6);
-        for (size_t j = 0; j < data[i].size() - 1; ++j)
-        {
-            ss << data[i][j] << ",";
-        }
-        ss << data[i][data[i].size() - 1] << "\r\n";
-        file.write(ss.str());
-    }
+    detail::csv_write_container_rows(file, data);
     file.close();
     return true;
 }
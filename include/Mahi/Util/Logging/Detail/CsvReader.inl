@@ -0,0 +1,143 @@
+namespace mahi {
+namespace util {
+
+template <typename Container1D>
+void CsvReader::parse_line(const char* p, const char* eol, Container1D& out, std::size_t n, std::size_t col_offset) const {
+    std::size_t col_r_idx = 0;
+    std::size_t col_w_idx = 0;
+    while (col_w_idx < n) {
+        const char* delim = static_cast<const char*>(std::memchr(p, delimiter_, static_cast<std::size_t>(eol - p)));
+        const char* field_end = delim ? delim : eol;
+        if (col_r_idx++ >= col_offset)
+            parse_field(p, field_end, out[col_w_idx++]);
+        if (!delim)
+            break;
+        p = delim + 1;
+    }
+}
+
+template <typename Container2D>
+std::size_t CsvReader::Cursor::next(Container2D& data_out) {
+    std::size_t row_w_idx = 0;
+    while (p_ != reader_->end_ && row_w_idx < data_out.size()) {
+        const char* eol = reader_->line_end(p_);
+        reader_->parse_line(p_, eol, data_out[row_w_idx], data_out[row_w_idx].size(), col_offset_);
+        row_w_idx++;
+        p_ = eol == reader_->end_ ? reader_->end_ : eol + 1;
+    }
+    row_ += row_w_idx;
+    return row_w_idx;
+}
+
+template <typename Container1D>
+bool CsvReader::read_row(Container1D& data_out, std::size_t row_offset, std::size_t col_offset) const {
+    const char* p = seek_row(row_offset);
+    if (p == end_)
+        return false;
+    parse_line(p, line_end(p), data_out, data_out.size(), col_offset);
+    return true;
+}
+
+template <typename Container2D>
+std::size_t CsvReader::read_rows(Container2D& data_out, std::size_t row_offset, std::size_t col_offset, std::size_t threads, ThreadPool* pool) const {
+    const char* p = seek_row(row_offset);
+    if (threads != 1) {
+        if (threads == 0)
+            threads = pool ? pool->size() : ThreadPool::hardware_threads();
+        std::vector<const char*> bounds = split_lines(p, threads);
+        const std::size_t parts = bounds.size() - 1;
+        if (parts > 1) {
+            std::unique_ptr<ThreadPool> local;
+            if (!pool) {
+                local.reset(new ThreadPool(parts));
+                pool = local.get();
+            }
+            // count the rows of each range, then parse each range into its rows
+            std::vector<std::size_t> first_row(parts + 1, 0);
+            pool->parallel_for(parts, [&](std::size_t k) {
+                first_row[k + 1] = count_lines(bounds[k], bounds[k + 1]);
+            });
+            for (std::size_t k = 0; k < parts; ++k)
+                first_row[k + 1] += first_row[k];
+            const std::size_t rows = (std::min)(first_row[parts], static_cast<std::size_t>(data_out.size()));
+            pool->parallel_for(parts, [&](std::size_t k) {
+                const char* q = bounds[k];
+                for (std::size_t r = first_row[k]; q != bounds[k + 1] && r < rows; ++r) {
+                    const char* eol = line_end(q);
+                    parse_line(q, eol, data_out[r], data_out[r].size(), col_offset);
+                    q = eol == end_ ? end_ : eol + 1;
+                }
+            });
+            return rows;
+        }
+    }
+    std::size_t row_w_idx = 0;
+    while (p != end_ && row_w_idx < data_out.size()) {
+        const char* eol = line_end(p);
+        parse_line(p, eol, data_out[row_w_idx], data_out[row_w_idx].size(), col_offset);
+        row_w_idx++;
+        p = eol == end_ ? end_ : eol + 1;
+    }
+    return row_w_idx;
+}
+
+template <typename T>
+std::size_t CsvReader::read_column(std::vector<T>& column_out, std::size_t col, std::size_t row_offset) const {
+    column_out.clear();
+    const char* p = seek_row(row_offset);
+    while (p != end_) {
+        const char* eol = line_end(p);
+        const char* first;
+        const char* last;
+        column_out.push_back(T());
+        if (find_field(p, eol, col, first, last))
+            parse_field(first, last, column_out.back());
+        p = eol == end_ ? end_ : eol + 1;
+    }
+    return column_out.size();
+}
+
+template <typename T>
+std::size_t CsvReader::read_columns(std::vector<std::vector<T>>& columns_out, std::size_t row_offset, std::size_t col_offset) const {
+    const std::size_t n = columns_out.size();
+    for (std::size_t c = 0; c < n; ++c)
+        columns_out[c].clear();
+    std::vector<T> row(n);
+    std::size_t rows = 0;
+    const char* p = seek_row(row_offset);
+    while (p != end_) {
+        const char* eol = line_end(p);
+        for (std::size_t c = 0; c < n; ++c)
+            row[c] = T();
+        parse_line(p, eol, row, n, col_offset);
+        for (std::size_t c = 0; c < n; ++c)
+            columns_out[c].push_back(row[c]);
+        rows++;
+        p = eol == end_ ? end_ : eol + 1;
+    }
+    return rows;
+}
+
+template <typename... Ts>
+bool CsvReader::read_row(const CsvSchema<Ts...>& schema, std::tuple<Ts...>& row_out, std::size_t row_offset) const {
+    const char* p = seek_row(row_offset);
+    if (p == end_)
+        return false;
+    return schema.parse_row(p, line_end(p), row_out, delimiter_);
+}
+
+template <typename... Ts>
+std::size_t CsvReader::read_rows(const CsvSchema<Ts...>& schema, std::vector<std::tuple<Ts...>>& rows_out, std::size_t row_offset) const {
+    rows_out.clear();
+    const char* p = seek_row(row_offset);
+    while (p != end_) {
+        const char* eol = line_end(p);
+        rows_out.push_back(std::tuple<Ts...>());
+        schema.parse_row(p, eol, rows_out.back(), delimiter_);
+        p = eol == end_ ? end_ : eol + 1;
+    }
+    return rows_out.size();
+}
+
+} // namespace util
+} // namespace mahi
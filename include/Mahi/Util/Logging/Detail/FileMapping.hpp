@@ -0,0 +1,65 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#pragma once
+
+#include <Mahi/Util/Types.hpp>
+#include <Mahi/Util/NonCopyable.hpp>
+#include <string>
+
+namespace mahi {
+namespace util {
+namespace detail {
+
+/// Read-only memory mapping of an entire file (used by the file readers)
+class FileMapping : public NonCopyable {
+public:
+    FileMapping();
+
+    ~FileMapping();
+
+    /// Opens and maps a file (empty files are opened but not mapped)
+    bool open(const std::string& filepath);
+
+    /// Unmaps and closes the file
+    void close();
+
+    /// Returns true if the file is open
+    bool is_open() const;
+
+    /// Returns the mapped contents (nullptr if empty)
+    const char* data() const { return data_; }
+
+    /// Returns the size of the file in bytes
+    std::size_t size() const { return size_; }
+
+    /// Returns the modification time of the file (0 if unknown)
+    int64 modified_time() const;
+
+private:
+#ifdef _WIN32
+    void* file_handle_;     ///< file handle
+    void* mapping_handle_;  ///< file mapping handle
+#else
+    int file_handle_;       ///< file handle
+#endif
+    const char* data_;      ///< mapped contents
+    std::size_t size_;      ///< size of mapped contents
+};
+
+} // namespace detail
+} // namespace util
+} // namespace mahi
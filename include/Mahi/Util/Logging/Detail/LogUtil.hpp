@@ -21,7 +21,30 @@
 #include <Mahi/Util/Console.hpp>
 #include <Mahi/Util/System.hpp>
 #include <Mahi/Util/Timing/Timestamp.hpp>
+#include <Mahi/Util/NonCopyable.hpp>
+#include <ostream>
+#include <streambuf>
 #include <sys/stat.h>
+#include <type_traits>
+
+/// Size (in chars) of the message buffer stored inside each LogRecord
+#ifndef MAHI_LOG_RECORD_SIZE
+#define MAHI_LOG_RECORD_SIZE 256
+#endif
+
+/// Size (in chars) of the processed function name returned by LogRecord::get_func()
+#ifndef MAHI_LOG_FUNC_SIZE
+#define MAHI_LOG_FUNC_SIZE 64
+#endif
+
+/// Clock used to timestamp log records (see Timestamp::Source)
+#ifndef MAHI_LOG_TIME_SOURCE
+#ifdef MAHI_LOG_COARSE_TIME
+#define MAHI_LOG_TIME_SOURCE mahi::util::Timestamp::RealtimeCoarse
+#else
+#define MAHI_LOG_TIME_SOURCE mahi::util::Timestamp::Realtime
+#endif
+#endif
 
 namespace mahi {
 namespace util {
@@ -67,65 +90,138 @@ inline Severity string_to_severity(const char* str) {
     return None;
 }
 
-/// Encapsulates a Log record
-class LogRecord {
+class LogRecord;
+
+namespace detail {
+
+/// std::ostream adapter which appends to a LogRecord's message buffer
+class LogStream : public std::streambuf {
+public:
+    /// Constructor
+    explicit LogStream(LogRecord& record);
+
+    std::ostream os;  ///< stream writing through this buffer
+
+protected:
+    virtual int_type overflow(int_type c) override;
+    virtual std::streamsize xsputn(const char* s, std::streamsize n) override;
+
+private:
+    LogRecord& record_;  ///< Record being appended to
+};
+
+} // namespace detail
+
+/// Encapsulates a Log record. The message is formatted into a fixed size
+/// inline buffer so that logging does not touch the heap. Messages which
+/// outgrow the buffer continue in a reusable thread-local arena.
+class LogRecord : NonCopyable {
 public:
     /// Constructor
     LogRecord(Severity severity,
            const char* func,
            size_t line,
            const char* file,
-           Timestamp timestamp = Timestamp());
+           Timestamp timestamp = Timestamp(MAHI_LOG_TIME_SOURCE));
+
+    /// Constructor for a Record made on another thread (e.g. by an asynchronous Logger)
+    LogRecord(Severity severity,
+           const char* func,
+           size_t line,
+           const char* file,
+           Timestamp timestamp,
+           unsigned int tid);
 
     /// Destructor
-    virtual ~LogRecord();
+    ~LogRecord();
 
-    // Stream operator overloads
+    // Stream operator overloads (common types are formatted without a std::ostream)
     LogRecord &operator<<(char data);
+    LogRecord &operator<<(bool data);
+    LogRecord &operator<<(short data);
+    LogRecord &operator<<(unsigned short data);
+    LogRecord &operator<<(int data);
+    LogRecord &operator<<(unsigned int data);
+    LogRecord &operator<<(long data);
+    LogRecord &operator<<(unsigned long data);
+    LogRecord &operator<<(long long data);
+    LogRecord &operator<<(unsigned long long data);
+    LogRecord &operator<<(float data);
+    LogRecord &operator<<(double data);
+    LogRecord &operator<<(long double data);
+    LogRecord &operator<<(const char* data);
+    LogRecord &operator<<(char* data);
+    LogRecord &operator<<(const std::string& data);
 
     LogRecord &operator<<(std::ostream &(*data)(std::ostream &));
 
     template <typename T>
     LogRecord& operator<<(const T& data) {
         using namespace detail;
-        message_ << data;
+        stream() << data;
         return *this;
     }
 
-    /// Gets the message contained by a Record
-    virtual const char* get_message() const;
+    /// Appends size characters to the message
+    LogRecord& append(const char* data, std::size_t size);
+
+    /// Gets the message contained by a Record (null terminated, not copied)
+    const char* get_message() const;
+
+    /// Gets the length of the message contained by a Record
+    std::size_t get_message_size() const;
 
     /// Returns timestamp at which Record was constructed
-    virtual const Timestamp& get_timestamp() const;
+    const Timestamp& get_timestamp() const;
 
     /// Gets the severity of a record
-    virtual Severity get_severity() const;
+    Severity get_severity() const;
 
     /// Gets ID of thread a Record was made on
-    virtual unsigned int get_tid_() const;
+    unsigned int get_tid_() const;
 
     /// Gets the line number where the Record was made
-    virtual size_t get_line() const;
+    size_t get_line() const;
 
     /// Gets the name of the function in which the Record was made
-    virtual const char* get_func() const;
+    const char* get_func() const;
+
+    /// Gets the unprocessed function signature captured when the Record was made
+    const char* get_func_signature() const;
 
     /// Gets the name of the file in which the Record was made
-    virtual const char* get_file() const;
+    const char* get_file() const;
+
+private:
+    friend class detail::LogStream;
+
+    /// Returns a std::ostream which appends to the message, creating it on first use
+    std::ostream& stream();
+
+    /// Makes room for at least size more characters, returns false if impossible
+    bool reserve(std::size_t size);
+
+    /// Appends a number formatted by printf-style format fmt
+    template <typename T>
+    LogRecord& append_printf(const char* fmt, T value);
 
 private:
     Timestamp timestamp_;              ///< timestamp
     const Severity severity_;          ///< Record severity
     const unsigned int tid_;           ///< thread ID
     const size_t line_;                ///< line number
-    std::ostringstream message_;       ///< string stream for message
     const char* const func_;           ///< function name string
     const char* const file_;           ///< file name string
-    mutable std::string func_str_;     ///< function name string
-    mutable std::string message_str_;  ///< message string
+    char* message_;                    ///< message buffer (inline_ or thread-local arena)
+    std::size_t size_;                 ///< message length
+    std::size_t capacity_;             ///< message buffer capacity (including null terminator)
+    bool arena_;                       ///< message_ points to the thread-local arena?
+    detail::LogStream* stream_;        ///< constructed in stream_storage_ on first use
+    mutable char func_str_[MAHI_LOG_FUNC_SIZE];       ///< processed function name
+    char inline_[MAHI_LOG_RECORD_SIZE];                ///< inline message buffer
+    std::aligned_storage<sizeof(detail::LogStream), alignof(detail::LogStream)>::type stream_storage_;  ///< storage for stream_
 };
 
-inline std::string process_function_name(const char* func);
 
 }  // namespace util
 }  // namespace mahi
\ No newline at end of file
@@ -23,7 +23,9 @@
 namespace mahi {
 namespace util {
 
-/// Representats a file resource
+/// Representats a file resource. open, write, sync and close are
+/// virtual so that derived classes which buffer data (e.g. Csv) stay
+/// consistent when used through a File reference.
 class File : NonCopyable {
 public:
 
@@ -37,22 +39,26 @@ public:
     virtual ~File();
 
     /// Opens the file for input-output operations
-    bool open(const std::string &filepath, WriteMode mode = Truncate, OpenMode o_mode = OpenOrCreate);
+    virtual bool open(const std::string &filepath, WriteMode mode = Truncate, OpenMode o_mode = OpenOrCreate);
 
     /// Writes to the file if the file is open
-    int write(const void* data, std::size_t count);
+    virtual int write(const void* data, std::size_t count);
 
     /// Writes to the file if the file is open
     template <class CharType>
     int write(const std::basic_string<CharType>& str) {
         return write(str.data(), str.size() * sizeof(CharType));
     }
+
+    /// Commits written data to the storage device (fsync). If data_only is
+    /// true, metadata not needed to read the data back is not flushed (fdatasync).
+    virtual bool sync(bool data_only = false);
     
     /// Returns true if file is open
-    bool is_open();
+    bool is_open() const;
 
     /// Closes the file if the file is open
-    void close();
+    virtual void close();
 
 public:
 
@@ -17,6 +17,8 @@
 #pragma once
 
 #include <Mahi/Util/Logging/Detail/LogUtil.hpp>
+#include <fmt/format.h>
+#include <cstring>
 #include <iomanip>
 
 namespace mahi {
@@ -31,13 +33,44 @@ public:
     static std::string header() { return std::string(); }
 
     static std::string format(const LogRecord& record) {
-        std::ostringstream ss;
-        ss << record.get_timestamp().yyyy_mm_dd_hh_mm_ss_mmm() << " ";
-        ss << std::setfill(' ') << std::setw(5) << std::left
-           << severity_to_string(record.get_severity()) << " ";
-        ss << "[" << record.get_tid_() << "] ";
-        ss << record.get_message() << "\n";
-        return ss.str();
+        char prefix[Timestamp::MaxSize + 32];
+        char* p = write_prefix(record, prefix);
+        std::string str;
+        str.reserve(static_cast<std::size_t>(p - prefix) + record.get_message_size() + 1);
+        str.append(prefix, p);
+        str.append(record.get_message(), record.get_message_size());
+        str.push_back('\n');
+        return str;
+    }
+
+    /// Appends the formatted record to buf (avoids a string per record)
+    static void format_to(fmt::memory_buffer& buf, const LogRecord& record) {
+        char prefix[Timestamp::MaxSize + 32];
+        char* p = write_prefix(record, prefix);
+        buf.append(prefix, p);
+        buf.append(record.get_message(), record.get_message() + record.get_message_size());
+        buf.push_back('\n');
+    }
+
+private:
+    /// Writes "timestamp severity [tid] " to prefix, returns the end
+    static char* write_prefix(const LogRecord& record, char* prefix) {
+        char* p = record.get_timestamp().write_yyyy_mm_dd_hh_mm_ss_mmm(prefix);
+        *p++ = ' ';
+        const char* severity = severity_to_string(record.get_severity());
+        const std::size_t severity_size = std::strlen(severity);
+        std::memcpy(p, severity, severity_size);
+        p += severity_size;
+        for (std::size_t i = severity_size; i < 5; ++i)
+            *p++ = ' ';
+        *p++ = ' ';
+        *p++ = '[';
+        fmt::format_int tid(record.get_tid_());
+        std::memcpy(p, tid.data(), tid.size());
+        p += tid.size();
+        *p++ = ']';
+        *p++ = ' ';
+        return p;
     }
 };
 } // namespace util
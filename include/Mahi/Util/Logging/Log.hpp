@@ -16,12 +16,17 @@
 
 #pragma once
 
+#include <Mahi/Util/Logging/Detail/AsyncLog.hpp>
 #include <Mahi/Util/Logging/Formatters/TxtFormatter.hpp>
 #include <Mahi/Util/Logging/Writers/ColorConsoleWriter.hpp>
 #include <Mahi/Util/Logging/Writers/RollingFileWriter.hpp>
 #include <Mahi/Util/Logging/Writers/Writer.hpp>
+#include <Mahi/Util/Templates/MPSCQueue.hpp>
 #include <Mahi/Util/Templates/Singleton.hpp>
+#include <atomic>
 #include <cstring>
+#include <memory>
+#include <thread>
 #include <vector>
 
 #ifndef DEFAULT_LOGGER
@@ -53,7 +58,19 @@ template <int instance>
 class Logger : public Singleton<Logger<instance> >, public Writer {
 public:
     /// Constructs a new Logger instance with a max severity
-    Logger(Severity maxSeverity = None) : Writer(maxSeverity) {}
+    Logger(Severity maxSeverity = None) :
+        Writer(maxSeverity),
+        async_(false),
+        running_(false),
+        pushed_(0),
+        written_(0),
+        dropped_(0)
+    {}
+
+    /// Destructor. Drains and stops the background thread if async.
+    ~Logger() {
+        disable_async();
+    }
 
     /// Adds a write to the Logger
     Logger& add_writer(Writer* writer) {
@@ -74,6 +91,69 @@ public:
     }
 
     void operator+=(const LogRecord& record) {
+        if (async_.load(std::memory_order_acquire) && !on_worker_thread())
+            enqueue(record);
+        else
+            dispatch(record);
+    }
+
+    virtual void set_max_severity(Severity severity) override {
+        max_severity_ = severity;
+        for (std::size_t i = 0; i < writers_.size(); ++i)
+            writers_[i]->set_max_severity(severity);
+    }
+
+    /// Switches the Logger to asynchronous mode. Records are copied into a
+    /// bounded lock-free queue and a background thread formats and writes
+    /// them to the Writers. Should be called before other threads log.
+    Logger& enable_async(const AsyncLogOptions& options = AsyncLogOptions()) {
+        disable_async();
+        options_ = options;
+        queue_.reset(new MPSCQueue<detail::QueuedLogRecord>(options_.capacity));
+        running_.store(true, std::memory_order_release);
+        worker_ = std::thread(&Logger::run, this);
+        async_.store(true, std::memory_order_release);
+        return *this;
+    }
+
+    /// Drains the queue, stops the background thread, and returns to
+    /// synchronous mode. Should be called after other threads stop logging.
+    void disable_async() {
+        if (!async_.load(std::memory_order_acquire))
+            return;
+        async_.store(false, std::memory_order_release);
+        running_.store(false, std::memory_order_release);
+        if (worker_.joinable())
+            worker_.join();
+        drain();
+    }
+
+    /// Returns true if the Logger is in asynchronous mode
+    bool is_async() const {
+        return async_.load(std::memory_order_acquire);
+    }
+
+    /// Blocks until every record logged before this call has been written,
+    /// then flushes all Writers
+    virtual void flush() override {
+        if (async_.load(std::memory_order_acquire) && !on_worker_thread()) {
+            const uint64 target = pushed_.load(std::memory_order_acquire);
+            while (written_.load(std::memory_order_acquire) < target &&
+                   running_.load(std::memory_order_acquire))
+                std::this_thread::yield();
+        }
+        for (std::size_t i = 0; i < writers_.size(); ++i)
+            writers_[i]->flush();
+    }
+
+    /// Gets the number of records discarded by the overflow policy
+    uint64 get_dropped() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+private:
+    /// Passes a Record to all Writers on the calling thread
+    void dispatch(const LogRecord& record) {
         for (std::vector<Writer*>::iterator it = writers_.begin();
              it != writers_.end(); ++it) {
             if ((*it)->check_severity(record.get_severity()))
@@ -81,14 +161,98 @@ public:
         }
     }
 
-    virtual void set_max_severity(Severity severity) override {
-        max_severity_ = severity;
-        for (std::size_t i = 0; i < writers_.size(); ++i)
-            writers_[i]->set_max_severity(severity);
+    /// Places a Record in the queue according to the overflow policy
+    void enqueue(const LogRecord& record) {
+        detail::QueuedLogRecord queued(record);
+        // take a ticket before publishing, so that flush() on any thread which
+        // happens after this call waits for this record
+        pushed_.fetch_add(1, std::memory_order_acq_rel);
+        if (queue_->try_push(queued))
+            return;
+        if (options_.overflow == AsyncLogOptions::Block) {
+            while (!queue_->try_push(queued))
+                std::this_thread::yield();
+        }
+        else if (options_.overflow == AsyncLogOptions::DropOldest) {
+            detail::QueuedLogRecord oldest;
+            while (!queue_->try_push(queued)) {
+                if (queue_->try_pop(oldest)) {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    written_.fetch_add(1, std::memory_order_release);
+                }
+            }
+        }
+        else {
+            // retire the ticket (a flush() may already be waiting on it)
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            written_.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    /// Writes all queued Records, returns the number written
+    std::size_t drain() {
+        std::size_t count = 0;
+        detail::QueuedLogRecord& queued = scratch_;
+        while (queue_ && queue_->try_pop(queued)) {
+            LogRecord record(queued.severity, queued.func, queued.line, queued.file,
+                             queued.timestamp, queued.tid);
+            record.append(queued.message, queued.size);
+            dispatch(record);
+            written_.fetch_add(1, std::memory_order_release);
+            ++count;
+        }
+        return count;
+    }
+
+    /// Background thread function
+    void run() {
+        on_worker_thread() = true;
+        uint64 reported = dropped_.load(std::memory_order_relaxed);
+        bool unflushed = false;
+        while (true) {
+            bool stop = !running_.load(std::memory_order_acquire);
+            std::size_t count = drain();
+            if (count > 0) {
+                unflushed = true;
+            }
+            else if (unflushed) {
+                // the queue went idle, so push out anything Writers buffered
+                for (std::size_t i = 0; i < writers_.size(); ++i)
+                    writers_[i]->flush();
+                unflushed = false;
+            }
+            uint64 dropped = dropped_.load(std::memory_order_relaxed);
+            if (dropped != reported) {
+                dispatch(LogRecord(Warning, LOG_GET_FUNC(), __LINE__, LOG_GET_FILE())
+                         << "Logger " << instance << " dropped " << (dropped - reported)
+                         << " record(s) because its queue was full");
+                reported = dropped;
+            }
+            if (stop)
+                break;
+            if (count == 0)
+                sleep(options_.poll_period);
+        }
+        on_worker_thread() = false;
+    }
+
+    /// True on the background thread, so that Writers which log don't re-enter the queue
+    static bool& on_worker_thread() {
+        static thread_local bool flag = false;
+        return flag;
     }
 
 private:
     std::vector<Writer*> writers_;  ///< writers for this Logger
+    AsyncLogOptions options_;       ///< async options
+    std::unique_ptr<MPSCQueue<detail::QueuedLogRecord> > queue_; ///< async record queue
+    detail::QueuedLogRecord scratch_; ///< reused by the draining thread
+    std::thread worker_;            ///< async background thread
+    std::atomic<bool> async_;       ///< async mode enabled?
+    std::atomic<bool> running_;     ///< background thread should keep running?
+    std::atomic<uint64> pushed_;    ///< records accepted by enqueue (counted before they are queued)
+    std::atomic<uint64> written_;   ///< records written or dropped
+    std::atomic<uint64> dropped_;   ///< records discarded due to overflow
 };
 
 //==============================================================================
@@ -111,6 +275,14 @@ inline Logger<instance>& init_logger(Severity max_severity, Writer* writer) {
     return logger;
 }
 
+/// Initializes an asynchronous logger with a custom Writer (specific logger
+/// instance). The Writer is invoked from the Logger's background thread.
+template <int instance>
+inline Logger<instance>& init_logger(Severity max_severity, Writer* writer,
+                                     const AsyncLogOptions& options) {
+    return init_logger<instance>(max_severity, writer).enable_async(options);
+}
+
 /// Initializes a logger with RollingFileWriter with any Formatter (specific
 /// logger instance)
 template <class Formatter, int instance>
@@ -0,0 +1,99 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#pragma once
+
+#include <Mahi/Util/Types.hpp>
+#include <Mahi/Util/NonCopyable.hpp>
+#include <string>
+
+namespace mahi {
+namespace util {
+
+/// Append-only file written through memory mapped chunks. Space is
+/// preallocated one chunk at a time, writers copy straight into the page
+/// cache, and the file is truncated to the length actually written on close.
+/// MappedFile is not thread-safe.
+class MappedFile : NonCopyable {
+public:
+
+    /// Default constructor
+    MappedFile();
+
+    /// Constructor with filepath provided (opens file)
+    MappedFile(const std::string& filepath, WriteMode w_mode = Truncate, OpenMode o_mode = OpenOrCreate,
+               std::size_t chunk_size = 16 * 1024 * 1024);
+
+    /// Default destructor (closes file if open)
+    ~MappedFile();
+
+    /// Opens the file, mapping chunk_size bytes at a time
+    bool open(const std::string& filepath, WriteMode w_mode = Truncate, OpenMode o_mode = OpenOrCreate,
+              std::size_t chunk_size = 16 * 1024 * 1024);
+
+    /// Appends size bytes to the file and returns a pointer to them, or
+    /// nullptr on failure. The pointer is valid until the next call to
+    /// reserve(), write(), or close().
+    char* reserve(std::size_t size);
+
+    /// Appends data to the file if the file is open
+    int write(const void* data, std::size_t size);
+
+    /// Appends data to the file if the file is open
+    template <class CharType>
+    int write(const std::basic_string<CharType>& str) {
+        return write(str.data(), str.size() * sizeof(CharType));
+    }
+
+    /// Commits written data to the storage device
+    bool sync();
+
+    /// Returns the number of bytes written to the file
+    uint64 size() const;
+
+    /// Returns true if file is open
+    bool is_open() const;
+
+    /// Unmaps the file and truncates it to the length written
+    void close();
+
+private:
+
+    /// Maps a chunk which covers [size_, end), extending the file if needed
+    bool map_chunk(uint64 end);
+
+    /// Unmaps the current chunk
+    void unmap_chunk();
+
+private:
+
+#ifdef _WIN32
+    void* file_handle_;     ///< file handle
+    void* mapping_handle_;  ///< file mapping handle
+#else
+    int file_handle_;       ///< file handle
+#endif
+    std::string filepath_;   ///< path of the open file
+    char* chunk_;            ///< mapped chunk
+    uint64 chunk_offset_;    ///< file offset of chunk_
+    std::size_t chunk_size_; ///< length of chunk_
+    std::size_t min_chunk_;  ///< requested chunk size
+    uint64 size_;            ///< bytes written
+    uint64 capacity_;        ///< bytes allocated in the file
+};
+
+} // namespace util
+} // namespace mahi
@@ -18,31 +18,115 @@
 #include <Mahi/Util/Logging/File.hpp>
 #include <Mahi/Util/Logging/Writers/Writer.hpp>
 #include <Mahi/Util/Concurrency/Mutex.hpp>
+#include <Mahi/Util/Timing/Clock.hpp>
+#include <fmt/format.h>
 #include <algorithm>
+#include <thread>
+#include <vector>
 
 namespace mahi {
 namespace util {
 
+namespace detail {
+
+/// Detects Formatters with a static format_to(fmt::memory_buffer&, const LogRecord&)
+template <class Formatter>
+class has_format_to {
+    template <class U>
+    static char test(decltype(U::format_to(std::declval<fmt::memory_buffer&>(), std::declval<const LogRecord&>()))*);
+    template <class U>
+    static long test(...);
+public:
+    static const bool value = sizeof(test<Formatter>(nullptr)) == 1;
+};
+
+/// Appends a formatted record to buf, without a temporary string if the
+/// Formatter supports it
+template <class Formatter>
+typename std::enable_if<has_format_to<Formatter>::value>::type
+format_to(fmt::memory_buffer& buf, const LogRecord& record) {
+    Formatter::format_to(buf, record);
+}
+
+template <class Formatter>
+typename std::enable_if<!has_format_to<Formatter>::value>::type
+format_to(fmt::memory_buffer& buf, const LogRecord& record) {
+    std::string str = Formatter::format(record);
+    buf.append(str.data(), str.data() + str.size());
+}
+
+} // namespace detail
+
 //==============================================================================
 // CLASS DECLARATION
 //==============================================================================
 
+/// Configures buffering, durability and rotation of a RollingFileWriter
+struct RollingFileOptions {
+    /// When written data is committed to the storage device
+    enum SyncPolicy {
+        SyncNever,    ///< leave it to the operating system
+        SyncOnRoll,   ///< fsync each file when it is rolled or closed
+        SyncPeriodic  ///< fdatasync at most every sync_period while writing
+    };
+
+    /// Constructor
+    RollingFileOptions(std::size_t buffer_size  = 0,
+                       Time        flush_period = milliseconds(100),
+                       SyncPolicy  sync         = SyncNever,
+                       Time        sync_period  = seconds(1),
+                       bool        background_roll = false) :
+        buffer_size(buffer_size),
+        flush_period(flush_period),
+        sync(sync),
+        sync_period(sync_period),
+        background_roll(background_roll) {}
+
+    std::size_t buffer_size; ///< bytes held in memory before a write (0 = unbuffered)
+    /// Maximum age of buffered records before a write. It is only checked
+    /// when a record arrives, so records logged by a synchronous Logger which
+    /// then goes quiet stay buffered until the next record, flush() or
+    /// destruction. An asynchronous Logger flushes its Writers whenever its
+    /// queue goes idle, so this does not apply to it.
+    Time flush_period;
+    SyncPolicy sync;         ///< durability policy
+    Time sync_period;        ///< interval of SyncPeriodic
+    bool background_roll;    ///< shift rolled files on a background thread
+};
+
+/// Writes formatted records to a file, rolling to numbered files once
+/// max_file_size is exceeded. With RollingFileOptions::buffer_size > 0,
+/// records are formatted into one reusable memory buffer which is written
+/// with a single write when it fills, the oldest record is older than
+/// flush_period (checked on each write), flush() is called, or an
+/// asynchronous Logger goes idle.
 template <class Formatter>
 class RollingFileWriter : public Writer {
 public:
     RollingFileWriter(const std::string& filename,
                       size_t max_file_size = 0,
                       int max_files       = 0,
-                      Severity max_severity = Debug)
+                      Severity max_severity = Debug,
+                      const RollingFileOptions& options = RollingFileOptions())
         : Writer(max_severity),
           file_size_(),
           max_file_size_((std::max)(static_cast<off_t>(max_file_size), static_cast<off_t>(1000))),
           last_file_number_((std::max)(max_files - 1, 0)),
-          first_write_(true) 
+          first_write_(true),
+          options_(options)
     {
         split_filename(filename, filename_no_ext_, file_ext_);
     }
 
+    ~RollingFileWriter() {
+        Lock lock(mutex_);
+        write_pending();
+        if (options_.sync != RollingFileOptions::SyncNever)
+            file_.sync();
+        if (roller_.joinable())
+            roller_.join();
+    }
+
     virtual void write(const LogRecord& record) {
         Lock lock(mutex_);
         if (first_write_) {
@@ -52,14 +136,76 @@ public:
         else if (last_file_number_ > 0 && file_size_ > max_file_size_ && -1 != file_size_) {
             roll_log_files();
         }
-        int bytes_written = file_.write(Formatter::format(record));
-        if (bytes_written > 0) {
-            file_size_ += bytes_written;
+        if (options_.buffer_size == 0) {
+            int bytes_written = file_.write(Formatter::format(record));
+            if (bytes_written > 0) {
+                file_size_ += bytes_written;
+            }
+            sync_periodic();
+            return;
+        }
+        if (pending_.size() == 0)
+            flush_clock_.restart();
+        const std::size_t before = pending_.size();
+        detail::format_to<Formatter>(pending_, record);
+        file_size_ += static_cast<off_t>(pending_.size() - before);
+        if (pending_.size() >= options_.buffer_size ||
+            flush_clock_.get_elapsed_time() >= options_.flush_period)
+        {
+            write_pending();
         }
     }
 
+    /// Writes buffered records to the file
+    virtual void flush() override {
+        Lock lock(mutex_);
+        write_pending();
+    }
+
 private:
+    /// Writes buffered records with a single write (more only if it is short)
+    void write_pending() {
+        if (pending_.size() == 0)
+            return;
+        const char* data = pending_.data();
+        std::size_t remaining = pending_.size();
+        while (remaining > 0) {
+            int bytes = file_.write(data, remaining);
+            if (bytes <= 0)
+                break;
+            data += bytes;
+            remaining -= static_cast<std::size_t>(bytes);
+        }
+        pending_.clear();
+        sync_periodic();
+    }
+
+    void sync_periodic() {
+        if (options_.sync == RollingFileOptions::SyncPeriodic &&
+            sync_clock_.get_elapsed_time() >= options_.sync_period) 
+        {
+            file_.sync(true);
+            sync_clock_.restart();
+        }
+    }
+
     void roll_log_files() {
+        write_pending();
+        if (roller_.joinable())
+            roller_.join(); // previous rotation must finish before the next
+        if (options_.background_roll) {
+            // move the full file aside and reopen immediately; the numbered
+            // files are shifted (and the old file synced) off this thread
+            file_.close();
+            std::string rolledFileName = build_file_name(-1);
+            File::rename(build_file_name(), rolledFileName);
+            open_log_file();
+            roller_ = std::thread(&RollingFileWriter::shift_log_files, rolledFileName,
+                                  build_file_names(), options_.sync == RollingFileOptions::SyncOnRoll);
+            return;
+        }
+        if (options_.sync == RollingFileOptions::SyncOnRoll)
+            file_.sync();
         file_.close();
 
         std::string lastFileName = build_file_name(last_file_number_);
@@ -74,6 +220,18 @@ private:
         open_log_file();
     }
 
+    /// Shifts numbered files (names[i] -> names[i+1]) and moves rolled into names[1]
+    static void shift_log_files(std::string rolledFileName, std::vector<std::string> names, bool sync) {
+        if (sync) {
+            File rolled(rolledFileName, WriteMode::Append, OpenMode::OpenOnly);
+            rolled.sync();
+        }
+        File::unlink(names.back());
+        for (std::size_t i = names.size() - 1; i > 1; --i)
+            File::rename(names[i - 1], names[i]);
+        File::rename(rolledFileName, names[1]);
+    }
+
     void open_log_file() {
         std::string fileName = build_file_name();
         file_size_ = file_.open(fileName, WriteMode::Append);
@@ -87,6 +245,15 @@ private:
         }
     }
 
+    /// Builds file names 0 through last_file_number_
+    std::vector<std::string> build_file_names() {
+        std::vector<std::string> names;
+        for (int fileNumber = 0; fileNumber <= last_file_number_; ++fileNumber)
+            names.push_back(build_file_name(fileNumber));
+        return names;
+    }
+
+    /// Builds a file name (fileNumber -1 is the temporary name of a rolled file)
     std::string build_file_name(int fileNumber = 0) {
         std::ostringstream ss;
         ss << filename_no_ext_;
@@ -94,6 +261,9 @@ private:
         if (fileNumber > 0) {
             ss << '.' << fileNumber;
         }
+        else if (fileNumber < 0) {
+            ss << ".rolling";
+        }
 
         if (!file_ext_.empty()) {
             ss << '.' << file_ext_;
@@ -111,6 +281,11 @@ private:
     std::string file_ext_;
     std::string filename_no_ext_;
     bool first_write_;
+    RollingFileOptions options_;
+    fmt::memory_buffer pending_;       ///< formatted records not yet written
+    Clock flush_clock_;                ///< age of the oldest pending record
+    Clock sync_clock_;                 ///< time since the last periodic sync
+    std::thread roller_;               ///< background rotation job
 };
 } // namespace util
 } // namespace mahi
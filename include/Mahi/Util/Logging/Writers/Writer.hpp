@@ -34,6 +34,9 @@ public:
 
     virtual void write(const LogRecord& record) = 0;
 
+    /// Forces any buffered output to its destination (default does nothing)
+    virtual void flush() {}
+
     Severity get_max_severity() const { return max_severity_; }
 
     virtual void set_max_severity(Severity severity) { max_severity_ = severity; }
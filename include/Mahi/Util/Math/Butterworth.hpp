@@ -17,6 +17,7 @@
 #pragma once
 
 #include <Mahi/Util/Math/Filter.hpp>
+#include <Mahi/Util/Math/SosFilter.hpp>
 #include <Mahi/Util/Timing/Frequency.hpp>
 
 namespace mahi {
@@ -59,6 +60,16 @@ public:
     /// with specified cutoff and sample frequencies
     void configure(std::size_t n, Frequency cutoff, Frequency sample, Type type = Lowpass, unsigned int seeding = 0);
 
+    /// Designs an n-th order lowpass or highpass digital Butterworth filter
+    /// with normalized cutoff frequency Wn as ceil(n/2) second-order sections,
+    /// for use with SosFilter. Each section has unity gain in the passband and
+    /// sections are ordered with poles nearest the unit circle last.
+    static std::vector<Sos> design_sos(std::size_t n, double Wn, Type type = Lowpass);
+
+    /// Designs an n-th order lowpass or highpass digital Butterworth filter
+    /// with specified cutoff and sample frequencies as second-order sections
+    static std::vector<Sos> design_sos(std::size_t n, Frequency cutoff, Frequency sample, Type type = Lowpass);
+
 };
 
 } // namespace util
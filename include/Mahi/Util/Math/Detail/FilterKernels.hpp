@@ -0,0 +1,60 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#pragma once
+
+#include <cstddef>
+
+namespace mahi {
+namespace util {
+namespace detail {
+
+/// Largest filter order handled by the block kernels (higher orders fall
+/// back to sample-by-sample direct form II transposed)
+const std::size_t FILTER_BLOCK_MAX_ORDER = 32;
+
+/// Number of samples processed per block by iir_block
+const std::size_t FILTER_BLOCK_SIZE = 256;
+
+/// Returns true if the SIMD (AVX) kernels are used on this CPU
+bool filter_simd_enabled();
+
+/// Computes w[k] = sum(b[i] * x[k - i], i = 0..n) for k = 0..count-1, where
+/// x points n elements into a buffer (so x[-n]..x[-1] are readable). Uses
+/// AVX when the CPU supports it and a scalar loop otherwise; both sum in
+/// the same order and give identical results.
+void fir_block(const double* b, std::size_t n, const double* x, double* w, std::size_t count);
+
+/// Filters count samples with coefficients b and a (n + 1 each) and direct
+/// form II transposed state s (n values), updating s. in and out may alias.
+/// The numerator is applied to whole blocks with fir_block and the
+/// denominator recursion runs with its history in registers, so results
+/// match sample-by-sample filtering to within rounding. Requires
+/// 1 <= n <= FILTER_BLOCK_MAX_ORDER.
+void iir_block(const double* b, const double* a, std::size_t n, double* s,
+               const double* in, double* out, std::size_t count);
+
+/// Applies one direct form II transposed step to each of channels filters
+/// sharing coefficients b and a (n + 1 each, n >= 1), with state i of
+/// channel c at s[i * stride + c]. Channels are processed four at a time with
+/// AVX when the CPU supports it, performing the same operations in the same
+/// order as Filter, so results are identical. x and y may alias.
+void bank_update(const double* b, const double* a, std::size_t n, double* s, std::size_t stride,
+                 const double* x, double* y, std::size_t channels);
+
+} // namespace detail
+} // namespace util
+} // namespace mahi
@@ -32,6 +32,14 @@ public:
     /// Applies the filter operation for one time step
     double update(const double x);
 
+    /// Applies the filter operation to n consecutive samples, equivalent to
+    /// calling update() on each (to within rounding) but several times
+    /// faster. The state stays in registers across each block and the
+    /// numerator uses SIMD (AVX) when the CPU supports it, so calls to
+    /// process() and update() can be freely mixed. in and out may be the
+    /// same array.
+    void process(const double* in, double* out, std::size_t n);
+
     /// Returns the filtered value since the last update
     double get_value() const;
 
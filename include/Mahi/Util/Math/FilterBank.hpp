@@ -0,0 +1,93 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Craig McDonald (craig.g.mcdonald@gmail.com)
+
+#pragma once
+
+#include <Mahi/Util/Math/Filter.hpp>
+#include <Mahi/Util/Templates/AlignedAllocator.hpp>
+#include <vector>
+
+namespace mahi {
+namespace util {
+
+/// Applies the same Filter to many channels (e.g. every joint of a robot) at
+/// once. Coefficients are shared and the channel states are stored
+/// interleaved (state i of every channel is contiguous and cache line
+/// aligned), so one update() filters all channels with SIMD (AVX) when the CPU
+/// supports it. Outputs are identical to those of independent Filter objects.
+class FilterBank {
+public:
+    /// Construct FilterBank of channels channels from transfer function
+    /// coefficients
+    FilterBank(const std::vector<double>& b,
+               const std::vector<double>& a,
+               std::size_t channels,
+               unsigned int seeding = 0);
+
+    /// Construct FilterBank of channels channels with the coefficients of an
+    /// existing Filter (e.g. a Butterworth design)
+    FilterBank(const Filter& filter, std::size_t channels, unsigned int seeding = 0);
+
+    /// Filters one sample of every channel. x and y must hold get_channels()
+    /// values and may be the same array.
+    void update(const double* x, double* y);
+
+    /// Filters one sample of every channel and returns the filtered values
+    const std::vector<double>& update(const std::vector<double>& x);
+
+    /// Returns the filtered value of a channel since the last update
+    double get_value(std::size_t channel) const;
+
+    /// Returns the filtered values of all channels since the last update
+    const std::vector<double>& get_values() const;
+
+    /// Returns the number of channels
+    std::size_t get_channels() const;
+
+    /// Sets the internal states of all channels to zero
+    void reset();
+
+    /// Returns the FilterBank numerator coefficients
+    const std::vector<double>& get_b() const;
+
+    /// Returns the FilterBank denominator coefficients
+    const std::vector<double>& get_a() const;
+
+    /// Set the FilterBank seeding
+    void set_seeding(unsigned int seeding);
+
+    /// Sets the FilterBank coefficients and resets all channels
+    void set_coefficients(const std::vector<double>& b,
+                          const std::vector<double>& a);
+
+private:
+    typedef std::vector<double, AlignedAllocator<double, 64>> AlignedVector;
+
+    std::size_t channels_;     ///< number of channels
+    std::size_t stride_;       ///< channels padded to a whole cache line
+    std::size_t n_;            ///< filter order
+    std::vector<double> b_;    ///< numerator coefficients
+    std::vector<double> a_;    ///< denominator coefficients
+    AlignedVector s_;          ///< internal memory, s_[i * stride_ + channel]
+    std::vector<double> y_;    ///< the filtered values
+    bool has_seeding_;         ///< indicates whether or not to seed on first update
+    bool first_update_;        ///< indicates first update upon reset
+    bool will_filter_;         ///< will the coefficients actually filter (i.e a and b are not both {1,0})?
+    unsigned int seed_count_;  ///< number of iterations to call on update upon seeding
+};
+
+} // namespace util
+} // namespace mahi
@@ -0,0 +1,154 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Craig McDonald (craig.g.mcdonald@gmail.com)
+
+#pragma once
+
+#include <Mahi/Util/Math/Filter.hpp>
+#include <array>
+
+namespace mahi {
+namespace util {
+
+namespace detail {
+
+/// Returns true if filter has order order, logging an error otherwise
+bool check_filter_order(const Filter& filter, std::size_t order);
+
+/// Unrolled direct form II transposed state update, s[I] for I = 0..N-1
+template <std::size_t I, std::size_t N, typename T, bool Last = (I + 1 == N)>
+struct FixedFilterStep {
+    static inline void apply(std::array<T, N>& s, const std::array<T, N + 1>& b,
+                             const std::array<T, N + 1>& a, T x, T y) {
+        s[I] = s[I + 1] + b[I + 1] * x - a[I + 1] * y;
+        FixedFilterStep<I + 1, N, T>::apply(s, b, a, x, y);
+    }
+};
+
+template <std::size_t I, std::size_t N, typename T>
+struct FixedFilterStep<I, N, T, true> {
+    static inline void apply(std::array<T, N>& s, const std::array<T, N + 1>& b,
+                             const std::array<T, N + 1>& a, T x, T y) {
+        s[I] = b[I + 1] * x - a[I + 1] * y;
+    }
+};
+
+} // namespace detail
+
+/// Direct form II transposed Filter with order fixed at compile time. All
+/// storage is inline (no heap allocation, trivially copyable, so arrays of
+/// FixedFilters are contiguous) and update() is fully unrolled and inlined.
+/// Coefficients are normalized so that a[0] == 1. For high orders in float,
+/// prefer SosFilter<float>.
+template <std::size_t Order, typename T = double>
+class FixedFilter {
+    static_assert(Order >= 1, "FixedFilter order must be at least 1");
+
+public:
+    typedef std::array<T, Order + 1> Coefficients;
+
+    /// Default constructor (does not filter)
+    FixedFilter() : seed_count_(0) {
+        Coefficients one = {};
+        one[0] = 1;
+        set_coefficients(one, one);
+    }
+
+    /// Construct FixedFilter from transfer function coefficients
+    FixedFilter(const Coefficients& b, const Coefficients& a, unsigned int seeding = 0) : seed_count_(seeding) {
+        set_coefficients(b, a);
+    }
+
+    /// Construct FixedFilter from the coefficients of a Filter design of the
+    /// same order, e.g. FixedFilter<2>(Butterworth(2, 0.1)). Logs an error and
+    /// does not filter if the orders differ.
+    explicit FixedFilter(const Filter& filter, unsigned int seeding = 0) : FixedFilter() {
+        seed_count_ = seeding;
+        if (detail::check_filter_order(filter, Order)) {
+            Coefficients b, a;
+            for (std::size_t i = 0; i <= Order; ++i) {
+                b[i] = static_cast<T>(filter.get_b()[i]);
+                a[i] = static_cast<T>(filter.get_a()[i]);
+            }
+            set_coefficients(b, a);
+        }
+    }
+
+    /// Applies the filter operation for one time step
+    inline T update(const T x) {
+        if (first_update_) {
+            first_update_ = false;
+            for (unsigned int i = 0; i < seed_count_; ++i)
+                step(x);
+        }
+        value_ = step(x);
+        return value_;
+    }
+
+    /// Applies the filter operation to n consecutive samples. in and out may
+    /// be the same array.
+    void process(const T* in, T* out, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i)
+            out[i] = update(in[i]);
+    }
+
+    /// Returns the filtered value since the last update
+    T get_value() const { return value_; }
+
+    /// Sets the internal states s_ to all be zero
+    void reset() {
+        s_.fill(0);
+        value_ = 0;
+        first_update_ = true;
+    }
+
+    /// Returns the normalized numerator coefficients
+    const Coefficients& get_b() const { return b_; }
+
+    /// Returns the normalized denominator coefficients
+    const Coefficients& get_a() const { return a_; }
+
+    /// Set the FixedFilter seeding
+    void set_seeding(unsigned int seeding) { seed_count_ = seeding; }
+
+    /// Sets the FixedFilter coefficients and resets it
+    void set_coefficients(const Coefficients& b, const Coefficients& a) {
+        const T a0 = a[0];
+        for (std::size_t i = 0; i <= Order; ++i) {
+            b_[i] = b[i] / a0;
+            a_[i] = a[i] / a0;
+        }
+        reset();
+    }
+
+private:
+    /// Direct form II transposed filter implementation
+    inline T step(const T x) {
+        const T y = s_[0] + b_[0] * x;
+        detail::FixedFilterStep<0, Order, T>::apply(s_, b_, a_, x, y);
+        return y;
+    }
+
+private:
+    Coefficients b_;                ///< numerator coefficients
+    Coefficients a_;                ///< denominator coefficients
+    std::array<T, Order> s_;        ///< internal memory
+    T value_;                       ///< the filtered value
+    unsigned int seed_count_;       ///< number of iterations to call on update upon seeding
+    bool first_update_;             ///< indicates first update upon reset
+};
+
+} // namespace util
+} // namespace mahi
@@ -0,0 +1,75 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Craig McDonald (craig.g.mcdonald@gmail.com)
+
+#pragma once
+
+#include <Mahi/Util/Math/Filter.hpp>
+#include <Mahi/Util/Math/SosFilter.hpp>
+#include <Mahi/Util/Timing/Frequency.hpp>
+#include <vector>
+
+// Offline (batch) signal processing of recorded data.
+
+namespace mahi {
+namespace util {
+
+class ThreadPool;
+
+/// Zero-phase filtering of n samples: filters forward, then backward, so the
+/// output has no phase lag and the magnitude response of filter squared
+/// (like MATLAB/SciPy filtfilt). The signal is padded at both ends with its
+/// odd reflection (3 * (order + 1) samples, at most n - 1) and both passes
+/// start from the filter's steady state for the first sample, so there are
+/// no startup transients. Only the coefficients of filter are used (not its
+/// state). in and out may be the same array.
+void filtfilt(const Filter& filter, const double* in, double* out, std::size_t n);
+
+/// Zero-phase filtering of n samples with second-order sections (e.g. from
+/// Butterworth::design_sos), which remain accurate for high orders and low
+/// cutoffs. in and out may be the same array.
+void filtfilt(const std::vector<Sos>& sos, const double* in, double* out, std::size_t n);
+
+/// Returns x filtered forward and backward (zero-phase) with filter
+std::vector<double> filtfilt(const Filter& filter, const std::vector<double>& x);
+
+/// Returns x filtered forward and backward (zero-phase) with sos
+std::vector<double> filtfilt(const std::vector<Sos>& sos, const std::vector<double>& x);
+
+/// Zero-phase filters each channel in place, in parallel on pool (or on a
+/// temporary ThreadPool using all hardware threads if pool is nullptr)
+void filtfilt(const Filter& filter, std::vector<std::vector<double>>& channels, ThreadPool* pool = nullptr);
+
+/// Zero-phase filters each channel in place with sos, in parallel on pool (or
+/// on a temporary ThreadPool using all hardware threads if pool is nullptr)
+void filtfilt(const std::vector<Sos>& sos, std::vector<std::vector<double>>& channels, ThreadPool* pool = nullptr);
+
+/// Downsamples x by an integer factor q, after zero-phase lowpass filtering
+/// with an order-th order Butterworth filter at 0.8 times the new Nyquist
+/// frequency to prevent aliasing. Returns ceil(x.size() / q) samples.
+std::vector<double> decimate(const std::vector<double>& x, std::size_t q, std::size_t order = 8);
+
+/// Resamples x by the rational factor up / down: x is upsampled by
+/// inserting zeros, zero-phase lowpass filtered with an order-th order
+/// Butterworth filter at 0.8 times the lower of the two Nyquist frequencies,
+/// then downsampled. Returns ceil(x.size() * up / down) samples. Uses
+/// x.size() * up / gcd(up, down) temporary samples.
+std::vector<double> resample(const std::vector<double>& x, std::size_t up, std::size_t down, std::size_t order = 8);
+
+/// Resamples x recorded at sample rate from to sample rate to
+std::vector<double> resample(const std::vector<double>& x, Frequency from, Frequency to, std::size_t order = 8);
+
+} // namespace util
+} // namespace mahi
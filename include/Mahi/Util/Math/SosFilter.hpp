@@ -0,0 +1,86 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Craig McDonald (craig.g.mcdonald@gmail.com)
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+namespace mahi {
+namespace util {
+
+/// Coefficients of one second-order section, {b0, b1, b2, a0, a1, a2}, i.e.
+/// H(z) = (b0 + b1 z^-1 + b2 z^-2) / (a0 + a1 z^-1 + a2 z^-2)
+typedef std::array<double, 6> Sos;
+
+/// Cascade of second-order sections (biquads), each in direct form II
+/// transposed. Unlike a single high-order Filter, the cascade stays accurate
+/// for high orders and low cutoffs, even in single precision (T = float),
+/// which also halves the coefficient and state memory. Only float and double
+/// are supported.
+template <typename T>
+class SosFilter {
+public:
+    /// Construct SosFilter from second-order sections (e.g. from
+    /// Butterworth::design_sos), applied in order
+    SosFilter(const std::vector<Sos>& sos, unsigned int seeding = 0);
+
+    /// Applies the filter operation for one time step
+    T update(const T x);
+
+    /// Applies the filter operation to n consecutive samples, equivalent to
+    /// calling update() on each. in and out may be the same array.
+    void process(const T* in, T* out, std::size_t n);
+
+    /// Returns the filtered value since the last update
+    T get_value() const;
+
+    /// Sets the internal states of all sections to zero
+    void reset();
+
+    /// Returns the number of second-order sections
+    std::size_t get_sections() const;
+
+    /// Returns the second-order sections, normalized so that a0 == 1
+    std::vector<Sos> get_sos() const;
+
+    /// Set the SosFilter seeding
+    void set_seeding(unsigned int seeding);
+
+    /// Sets the second-order sections and resets the filter
+    void set_sos(const std::vector<Sos>& sos);
+
+private:
+    /// Normalized section coefficients (a0 == 1)
+    struct Section {
+        T b0, b1, b2, a1, a2;
+    };
+
+    /// Calls the filter multiple times on the initial value to avoid startup
+    /// transients
+    void seed(const T x, const unsigned int iterations);
+
+private:
+    T value_;                            ///< the filtered value
+    std::vector<Section> sections_;      ///< section coefficients
+    std::vector<std::array<T, 2>> s_;    ///< internal memory of each section
+    bool has_seeding_;                   ///< indicates whether or not to call seed on first update
+    bool first_update_;                  ///< indicates first update upon reset
+    unsigned int seed_count_;            ///< number of iterations to call on update upon seeding
+};
+
+} // namespace util
+} // namespace mahi
@@ -0,0 +1,93 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#pragma once
+
+#include <Mahi/Util/Timing/Time.hpp>
+#include <Mahi/Util/Types.hpp>
+#include <string>
+#include <vector>
+
+namespace mahi {
+namespace util {
+
+/// Settings applied to the calling thread (and process) by configure_realtime()
+struct RealtimeConfig {
+    /// Real-time scheduling policy
+    enum Policy {
+        None,        ///< leave the scheduling policy unchanged
+        Fifo,        ///< SCHED_FIFO (REALTIME_PRIORITY_CLASS on Windows)
+        RoundRobin,  ///< SCHED_RR (REALTIME_PRIORITY_CLASS on Windows)
+        Deadline     ///< SCHED_DEADLINE (Linux only, uses runtime/deadline/period, requires no pinning)
+    };
+
+    /// Constructor (FIFO at max priority, memory locked, 256 KB of stack prefaulted)
+    RealtimeConfig();
+
+    Policy policy;                 ///< scheduling policy
+    int priority;                  ///< FIFO/RR priority, clamped to the policy's range (-1 = max)
+    Time runtime;                  ///< Deadline: CPU time budget per period
+    Time deadline;                 ///< Deadline: relative deadline of each period
+    Time period;                   ///< Deadline: period
+    std::vector<int> cpus;         ///< CPUs to pin the thread to (empty = unchanged)
+    bool isolated_cpus;            ///< pin to the kernel's isolated CPUs (isolcpus=) if cpus is empty
+    bool lock_memory;              ///< mlockall current and future pages
+    std::size_t prefault_stack;    ///< bytes of stack to touch so later calls don't fault
+    std::size_t prefault_heap;     ///< bytes of heap to touch and keep (disables heap trimming)
+    bool disable_thp;              ///< opt the process out of transparent huge pages
+};
+
+/// Outcome of each step of configure_realtime()
+struct RealtimeStatus {
+    /// Outcome of a step
+    enum Result {
+        Skipped,     ///< not requested
+        Ok,          ///< succeeded
+        Failed,      ///< failed (usually insufficient privileges)
+        Unsupported  ///< not available on this platform
+    };
+
+    /// Constructor (all steps Skipped)
+    RealtimeStatus();
+
+    /// Returns true if no step Failed
+    bool ok() const;
+
+    /// Returns a one line summary of each step, followed by failure messages
+    std::string summary() const;
+
+    Result scheduling;              ///< scheduling policy and priority
+    Result affinity;                ///< CPU pinning
+    Result memory_lock;             ///< mlockall
+    Result stack_prefault;          ///< stack prefaulting
+    Result heap_prefault;           ///< heap prefaulting
+    Result thp;                     ///< transparent huge page opt-out
+    std::vector<std::string> messages;  ///< reasons for Failed/Unsupported steps
+};
+
+/// Applies as much of config to the calling thread as the OS and the
+/// process's privileges allow. Every step is attempted independently, so an
+/// unprivileged process still gets e.g. its stack prefaulted and CPU pinned.
+/// Page faults and CPU migrations are the usual causes of worst-case latency
+/// spikes, so call this at the start of each real-time thread, before its loop.
+RealtimeStatus configure_realtime(const RealtimeConfig& config = RealtimeConfig());
+
+/// Returns the CPUs isolated from the scheduler with the isolcpus= kernel
+/// parameter (Linux only, empty otherwise)
+std::vector<int> get_isolated_cpus();
+
+} // namespace util
+} // namespace mahi
@@ -70,6 +70,9 @@ bool enable_realtime();
 /// Disables real-time OS priority. The program must be run 'As Administrator' on Windows.
 bool disable_realtime();
 
+/// Pins the calling thread to a single CPU core (not supported on macOS)
+bool set_thread_affinity(int cpu);
+
 /// Gets the operating system's ID number of the calling thread
 uint32 get_thread_id();
 
@@ -0,0 +1,83 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+namespace mahi {
+namespace util {
+
+/// Standard allocator returning memory aligned to Alignment bytes (a power of
+/// two, at least sizeof(void*)), e.g. std::vector<double, AlignedAllocator<double, 64>>
+/// for cache line aligned SIMD data
+template <typename T, std::size_t Alignment>
+class AlignedAllocator {
+public:
+    typedef T value_type;
+
+    template <typename U>
+    struct rebind {
+        typedef AlignedAllocator<U, Alignment> other;
+    };
+
+    AlignedAllocator() {}
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(std::size_t n) {
+        if (n == 0)
+            return nullptr;
+        void* p = nullptr;
+#ifdef _MSC_VER
+        p = _aligned_malloc(n * sizeof(T), Alignment);
+#else
+        if (posix_memalign(&p, Alignment, n * sizeof(T)) != 0)
+            p = nullptr;
+#endif
+        if (!p)
+            throw std::bad_alloc();
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, std::size_t) {
+#ifdef _MSC_VER
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+};
+
+template <typename T, typename U, std::size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) {
+    return true;
+}
+
+template <typename T, typename U, std::size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) {
+    return false;
+}
+
+} // namespace util
+} // namespace mahi
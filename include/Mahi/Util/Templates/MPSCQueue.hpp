@@ -0,0 +1,184 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace mahi {
+namespace util {
+
+/// Bounded, lock-free, multi-producer-single-consumer queue. Each slot carries
+/// a sequence number (D. Vyukov's bounded queue), so producers never wait on
+/// each other unless the queue is full. Because try_pop() also claims slots
+/// atomically, it is safe for a producer to evict the oldest element when the
+/// queue is full (see AsyncLogOptions::DropOldest).
+template <typename T>
+class MPSCQueue {
+public:
+    explicit MPSCQueue(const size_t capacity) :
+        capacity_(capacity),
+        slots_(capacity_ < 2 ? nullptr : new Slot[capacity_]),
+        head_(0),
+        tail_(0) {
+        if (capacity_ < 2) {
+            throw std::invalid_argument("size < 2");
+        }
+        for (size_t i = 0; i < capacity_; ++i)
+            slots_[i].turn.store(i, std::memory_order_relaxed);
+    }
+
+    ~MPSCQueue() {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        for (size_t tail = tail_.load(std::memory_order_relaxed); tail != head; ++tail) {
+            Slot &slot = slots_[tail % capacity_];
+            if (slot.turn.load(std::memory_order_relaxed) == tail + 1)
+                reinterpret_cast<T *>(&slot.storage)->~T();
+        }
+    }
+
+    // non-copyable and non-movable
+    MPSCQueue(const MPSCQueue &) = delete;
+    MPSCQueue &operator=(const MPSCQueue &) = delete;
+
+    /// Constructs an element in place, spinning while the queue is full
+    template <typename... Args>
+    void emplace(Args &&... args) noexcept(std::is_nothrow_constructible<T, Args &&...>::value) {
+        while (!try_emplace(std::forward<Args>(args)...))
+            ;
+    }
+
+    /// Constructs an element in place, or returns false if the queue is full
+    template <typename... Args>
+    bool try_emplace(Args &&... args) noexcept(
+        std::is_nothrow_constructible<T, Args &&...>::value) {
+        static_assert(std::is_constructible<T, Args &&...>::value,
+                      "T must be constructible with Args&&...");
+        Slot *slot;
+        size_t head = head_.load(std::memory_order_relaxed);
+        while (true) {
+            slot = &slots_[head % capacity_];
+            size_t         turn = slot->turn.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(turn) - static_cast<std::ptrdiff_t>(head);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(head, head + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0) {
+                return false;
+            }
+            else {
+                head = head_.load(std::memory_order_relaxed);
+            }
+        }
+        new (&slot->storage) T(std::forward<Args>(args)...);
+        slot->turn.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    void push(const T &v) noexcept(std::is_nothrow_copy_constructible<T>::value) {
+        static_assert(std::is_copy_constructible<T>::value, "T must be copy constructible");
+        emplace(v);
+    }
+
+    template <typename P,
+              typename = typename std::enable_if<std::is_constructible<T, P &&>::value>::type>
+    void push(P &&v) noexcept(std::is_nothrow_constructible<T, P &&>::value) {
+        emplace(std::forward<P>(v));
+    }
+
+    bool try_push(const T &v) noexcept(std::is_nothrow_copy_constructible<T>::value) {
+        static_assert(std::is_copy_constructible<T>::value, "T must be copy constructible");
+        return try_emplace(v);
+    }
+
+    template <typename P,
+              typename = typename std::enable_if<std::is_constructible<T, P &&>::value>::type>
+    bool try_push(P &&v) noexcept(std::is_nothrow_constructible<T, P &&>::value) {
+        return try_emplace(std::forward<P>(v));
+    }
+
+    /// Moves the oldest element into v, or returns false if the queue is empty
+    bool try_pop(T &v) noexcept {
+        static_assert(std::is_nothrow_destructible<T>::value, "T must be nothrow destructible");
+        Slot *slot;
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        while (true) {
+            slot = &slots_[tail % capacity_];
+            size_t         turn = slot->turn.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(turn) - static_cast<std::ptrdiff_t>(tail + 1);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0) {
+                return false;
+            }
+            else {
+                tail = tail_.load(std::memory_order_relaxed);
+            }
+        }
+        T *elem = reinterpret_cast<T *>(&slot->storage);
+        v = std::move(*elem);
+        elem->~T();
+        slot->turn.store(tail + capacity_, std::memory_order_release);
+        return true;
+    }
+
+    /// Approximate number of elements in the queue
+    size_t size() const noexcept {
+        std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(head_.load(std::memory_order_acquire)) -
+                              static_cast<std::ptrdiff_t>(tail_.load(std::memory_order_acquire));
+        return diff < 0 ? 0 : static_cast<size_t>(diff);
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    size_t capacity() const noexcept { return capacity_; }
+
+private:
+#ifdef MAHI_MYRIO
+    static constexpr size_t kCacheLineSize = 64;
+#else
+    static constexpr size_t kCacheLineSize = 128;
+#endif
+
+    struct Slot {
+        std::atomic<size_t>                                        turn;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+private:
+    const size_t                 capacity_;
+    const std::unique_ptr<Slot[]> slots_;
+
+    // Pad (rather than align, so the queue can be heap allocated in C++11)
+    // to avoid false sharing between head_, tail_ and adjacent allocations
+    char                padding0_[kCacheLineSize];
+    std::atomic<size_t> head_;
+    char                padding1_[kCacheLineSize - sizeof(head_)];
+    std::atomic<size_t> tail_;
+    char                padding2_[kCacheLineSize - sizeof(tail_)];
+};
+}  // namespace util
+}  // namespace mahi
@@ -0,0 +1,124 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#pragma once
+
+#include <Mahi/Util/Timing/Time.hpp>
+#include <Mahi/Util/Types.hpp>
+#include <limits>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace mahi {
+namespace util {
+
+/// Fixed-memory log-linear histogram of durations in nanoseconds. Values
+/// below 64 ns are counted exactly. Each power of two above that is split
+/// into 32 linear buckets, so percentiles are within ~3% of the true value,
+/// up to about 18 minutes (larger values land in the last bucket). Recording
+/// a value is a handful of integer operations and never allocates.
+class LatencyHistogram {
+public:
+    /// Number of buckets
+    static const std::size_t BucketCount = 1152;
+
+    /// Constructor
+    LatencyHistogram();
+
+    /// Records a duration in nanoseconds
+    void record(int64 ns) {
+        counts_[bucket_index(ns)]++;
+        count_++;
+        sum_ += ns;
+        if (ns < min_)
+            min_ = ns;
+        if (ns > max_)
+            max_ = ns;
+    }
+
+    /// Records a duration
+    void record(Time duration) { record(duration.as_nanoseconds()); }
+
+    /// Clears all recorded values
+    void reset();
+
+    /// Returns the number of recorded values
+    uint64 count() const { return count_; }
+
+    /// Returns the smallest recorded value [ns] (0 if empty)
+    int64 min() const { return count_ ? min_ : 0; }
+
+    /// Returns the largest recorded value [ns] (0 if empty)
+    int64 max() const { return count_ ? max_ : 0; }
+
+    /// Returns the mean of the recorded values [ns] (0 if empty)
+    double mean() const;
+
+    /// Returns the value below which fraction p (0 to 1) of the values fall [ns]
+    int64 percentile(double p) const;
+
+    /// Returns the count of bucket i
+    uint64 bucket_count(std::size_t i) const { return counts_[i]; }
+
+    /// Returns the smallest value counted in bucket i [ns]
+    static int64 bucket_lower(std::size_t i);
+
+    /// Returns the smallest value counted in the bucket after i [ns]
+    static int64 bucket_upper(std::size_t i);
+
+    /// Returns the bucket a value is counted in
+    static std::size_t bucket_index(int64 ns) {
+        if (ns < 64)
+            return ns > 0 ? static_cast<std::size_t>(ns) : 0;
+        const uint64 v = static_cast<uint64>(ns) < (uint64(1) << 40) ? static_cast<uint64>(ns) : (uint64(1) << 40) - 1;
+        const int msb = most_significant_bit(v);
+        return static_cast<std::size_t>((msb - 5) * 32) + static_cast<std::size_t>(v >> (msb - 5));
+    }
+
+    /// Returns a one line summary (count, min, mean, p50, p99, p99.9, max in microseconds)
+    std::string summary() const;
+
+private:
+    /// Returns the index of the highest set bit of v (v > 0)
+    static int most_significant_bit(uint64 v) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(v);
+#elif defined(_MSC_VER) && defined(_WIN64)
+        unsigned long index;
+        _BitScanReverse64(&index, v);
+        return static_cast<int>(index);
+#else
+        int msb = 0;
+        while (v >>= 1)
+            msb++;
+        return msb;
+#endif
+    }
+
+private:
+    std::vector<uint64> counts_; ///< bucket counts (allocated once)
+    uint64 count_;               ///< number of values
+    int64 sum_;                  ///< sum of values [ns]
+    int64 min_;                  ///< smallest value [ns]
+    int64 max_;                  ///< largest value [ns]
+};
+
+} // namespace util
+} // namespace mahi
@@ -0,0 +1,156 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#pragma once
+
+#include <Mahi/Util/NonCopyable.hpp>
+#include <Mahi/Util/Timing/Clock.hpp>
+#include <Mahi/Util/Timing/LatencyHistogram.hpp>
+#include <Mahi/Util/Types.hpp>
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace mahi {
+namespace util {
+
+/// A single timed scope, as recorded by the thread that ran it
+struct ProfileEvent {
+    uint32 site;   ///< id of the ProfileSite
+    int64  begin;  ///< Clock time on entry [ns]
+    int64  end;    ///< Clock time on exit [ns]
+};
+
+/// Aggregated timings of one profiled scope
+struct ProfileStats {
+    std::string      name;       ///< scope name
+    std::string      file;       ///< source file of the scope
+    int              line;       ///< source line of the scope
+    uint64           count;      ///< number of times the scope ran
+    Time             total;      ///< total time spent in the scope
+    Time             min;        ///< shortest run
+    Time             max;        ///< longest run
+    LatencyHistogram histogram;  ///< distribution of run times
+
+    /// Returns the mean run time
+    Time mean() const;
+    /// Returns the run time below which fraction p (0 to 1) of runs fall
+    Time percentile(double p) const;
+};
+
+/// Collects timings recorded with PROFILE_SCOPE. Each thread records events
+/// into its own lock-free buffer, allocated the first time it enters a
+/// profiled scope, so recording never locks or allocates. A non real-time
+/// thread should call collect() periodically to drain the buffers into the
+/// aggregate statistics (and trace, if enabled). Events recorded while a
+/// buffer is full are dropped and counted.
+class Profiler {
+public:
+    /// Enables or disables recording (enabled by default)
+    static void enable(bool enabled = true);
+
+    /// Returns true if recording is enabled
+    static bool is_enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    /// Sets the per-thread buffer capacity in events (default 16384). Only
+    /// affects threads which haven't yet entered a profiled scope.
+    static void set_buffer_capacity(std::size_t events);
+
+    /// Keeps up to max_events individual events for save_trace()
+    static void enable_trace(bool enabled = true, std::size_t max_events = 1000000);
+
+    /// Names the calling thread in traces
+    static void set_thread_name(const std::string& name);
+
+    /// Drains all thread buffers into the aggregate statistics
+    static void collect();
+
+    /// Collects and returns the statistics of every scope that has run
+    static std::vector<ProfileStats> get_stats();
+
+    /// Returns the number of events dropped because a thread buffer was full
+    static uint64 get_dropped();
+
+    /// Collects and returns a table of the statistics of every scope
+    static std::string summary();
+
+    /// Collects and saves traced events in Chrome trace-event JSON format,
+    /// which can be opened in chrome://tracing or https://ui.perfetto.dev
+    static bool save_trace(const std::string& filepath);
+
+    /// Discards all buffered events, statistics and trace events
+    static void reset();
+
+    /// Registers a scope and returns its id (use PROFILE_SCOPE instead)
+    static uint32 register_site(const char* name, const char* file, int line);
+
+    /// Records an event for the calling thread (use PROFILE_SCOPE instead)
+    static void record(uint32 site, int64 begin, int64 end);
+
+private:
+    static std::atomic<bool> enabled_;  ///< recording enabled
+};
+
+/// Static identity of a profiled scope
+class ProfileSite : NonCopyable {
+public:
+    /// Constructor
+    ProfileSite(const char* name, const char* file, int line) :
+        id(Profiler::register_site(name, file, line))
+    {
+    }
+
+    const uint32 id;  ///< id assigned by the Profiler
+};
+
+/// RAII object which records the time between its construction and destruction
+class ProfileScope : NonCopyable {
+public:
+    /// Constructor
+    explicit ProfileScope(const ProfileSite& site) :
+        site_(site.id),
+        begin_(Profiler::is_enabled() ? Clock::get_current_time().as_nanoseconds() : -1)
+    {
+    }
+
+    /// Destructor
+    ~ProfileScope() {
+        if (begin_ >= 0)
+            Profiler::record(site_, begin_, Clock::get_current_time().as_nanoseconds());
+    }
+
+private:
+    uint32 site_;   ///< site id
+    int64  begin_;  ///< entry time [ns], or -1 if disabled
+};
+
+} // namespace util
+} // namespace mahi
+
+#define MAHI_PROFILE_CAT_(a, b) a##b
+#define MAHI_PROFILE_CAT(a, b) MAHI_PROFILE_CAT_(a, b)
+
+#ifndef MAHI_DISABLE_PROFILE
+/// Profiles the remainder of the enclosing scope under name (a string literal)
+#define PROFILE_SCOPE(name)                                                                                      \
+    static const ::mahi::util::ProfileSite MAHI_PROFILE_CAT(mahi_profile_site_, __LINE__)(name, __FILE__, __LINE__); \
+    ::mahi::util::ProfileScope MAHI_PROFILE_CAT(mahi_profile_scope_, __LINE__)(MAHI_PROFILE_CAT(mahi_profile_site_, __LINE__))
+#else
+#define PROFILE_SCOPE(name) do {} while (0)
+#endif
+
+/// Profiles the remainder of the enclosing function
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
@@ -0,0 +1,129 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#pragma once
+
+#include <Mahi/Util/NonCopyable.hpp>
+#include <Mahi/Util/Realtime.hpp>
+#include <Mahi/Util/Timing/Frequency.hpp>
+#include <Mahi/Util/Timing/LatencyHistogram.hpp>
+#include <Mahi/Util/Timing/Timer.hpp>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mahi {
+namespace util {
+
+/// Runs periodic tasks of different rates on a small number of threads.
+///
+/// Each thread wakes at the greatest common divisor of its tasks' periods
+/// (its base period) using a Timer, and runs every task that is due on that
+/// tick. Tasks are grouped onto threads so that their rates are harmonic
+/// (e.g. 1000, 100 and 10 Hz share a 1 ms base tick), which keeps the
+/// number of wakeups low and gives every rate a fixed phase relationship to
+/// the others. Due tasks run earliest deadline first, which for tasks
+/// released together means fastest rate first, with ties broken by priority.
+/// A task overruns when it completes after its deadline (the scheduled
+/// time of its tick plus its period, so a late wakeup counts against it);
+/// overruns are counted per task.
+class RateScheduler : NonCopyable {
+public:
+    /// Execution statistics of a task
+    struct TaskStats {
+        std::string      name;       ///< task name
+        Frequency        frequency;  ///< task rate
+        int              priority;   ///< task priority
+        int              thread;     ///< thread the task runs on
+        int64            runs;       ///< number of times the task ran
+        int64            overruns;   ///< number of times the task completed after its deadline
+        LatencyHistogram exec_time;  ///< execution time of each run
+    };
+
+public:
+    /// Constructor. Tasks run on up to threads threads, which wait with the
+    /// given Timer wait mode.
+    explicit RateScheduler(std::size_t threads = 1, Timer::WaitMode mode = Timer::WaitMode::Deadline);
+
+    /// Destructor (stops the scheduler)
+    ~RateScheduler();
+
+    /// Adds a task that runs at frequency f. Higher priority tasks run first
+    /// among tasks with the same deadline. If thread is -1, the task is put on
+    /// a thread whose rates it is harmonic with or on an empty thread, falling
+    /// back to the thread whose base period it shortens the least. A thread's
+    /// base period may not fall below 10 us or 1/10 of its fastest task's
+    /// period (e.g. 1000 and 60 Hz, whose GCD is 2 ns, cannot share a thread).
+    /// Returns the task id, or -1 if the task could not be added (e.g. the
+    /// scheduler is running or no thread can take the rate).
+    int add_task(const std::string& name, Frequency f, std::function<void()> task, int priority = 0, int thread = -1);
+
+    /// Pins a thread to a CPU core when the scheduler starts
+    void set_thread_affinity(std::size_t thread, int cpu);
+
+    /// Configures the threads for real-time with a default RealtimeConfig when the scheduler starts
+    void set_realtime(bool realtime = true);
+
+    /// Configures the threads for real-time with config when the scheduler
+    /// starts. Threads with an affinity set pin to that CPU instead of config.cpus.
+    void set_realtime(const RealtimeConfig& config);
+
+    /// Starts running the tasks. Returns false if already running or no tasks were added.
+    bool start();
+
+    /// Stops running the tasks and joins the threads
+    void stop();
+
+    /// Returns true if the scheduler is running
+    bool is_running() const;
+
+    /// Returns the number of tasks
+    std::size_t get_task_count() const;
+
+    /// Returns the base period of a thread (Time::Zero if it has no tasks)
+    Time get_base_period(std::size_t thread) const;
+
+    /// Returns the statistics of a task. Counts can be read while running;
+    /// exec_time should only be read after stop().
+    TaskStats get_task_stats(std::size_t task) const;
+
+    /// Returns the number of base ticks a thread has missed
+    int64 get_misses(std::size_t thread) const;
+
+    /// Logs the statistics of every task
+    void log_statistics() const;
+
+private:
+    struct Task;
+    struct Worker;
+
+    /// Runs a worker thread
+    void run(Worker& worker);
+
+private:
+    Timer::WaitMode mode_;                          ///< wait mode of the thread Timers
+    bool realtime_;                                 ///< configure threads for real-time?
+    RealtimeConfig realtime_config_;                ///< real-time configuration of the threads
+    std::atomic<bool> running_;                     ///< threads should keep running?
+    std::vector<std::unique_ptr<Task>> tasks_;      ///< all tasks
+    std::vector<std::unique_ptr<Worker>> workers_;  ///< one per thread
+};
+
+} // namespace util
+} // namespace mahi
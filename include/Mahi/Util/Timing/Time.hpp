@@ -32,7 +32,8 @@ class Frequency;
 class Time {
 public:
     /// Default constructor. Sets time value to zero. To construct valued time
-    /// objects, use mahi::util::seconds, mahi::util::milliseconds or mahi::util::microseconds.
+    /// objects, use mahi::util::seconds, mahi::util::milliseconds, mahi::util::microseconds
+    /// or mahi::util::nanoseconds.
     Time();
 
     /// Overloads stream operator
@@ -47,6 +48,9 @@ public:
     /// Return the time value as a number of microseconds.
     int64 as_microseconds() const;
 
+    /// Return the time value as a number of nanoseconds.
+    int64 as_nanoseconds() const;
+
     /// Returns the reciprocal time as a Frequency
     Frequency to_frequency() const;
 
@@ -58,12 +62,13 @@ private:
     friend Time seconds(double);
     friend Time milliseconds(int32);
     friend Time microseconds(int64);
+    friend Time nanoseconds(int64);
 
-    /// Internal constructor from a number of microseconds.
-    explicit Time(int64 microseconds);
+    /// Internal constructor from a number of nanoseconds.
+    explicit Time(int64 nanoseconds);
 
 private:
-    int64 microseconds_;  ///< Time value stored as microseconds
+    int64 nanoseconds_;  ///< Time value stored as nanoseconds (+/-292 years)
 };
 
 //==============================================================================
@@ -79,6 +84,9 @@ Time milliseconds(int32 amount);
 /// Construct a time value from a number of microseconds
 Time microseconds(int64 amount);
 
+/// Construct a time value from a number of nanoseconds
+Time nanoseconds(int64 amount);
+
 //==============================================================================
 // USER DEFINED LITERALS
 //==============================================================================
@@ -95,6 +103,9 @@ Time operator ""_ms(unsigned long long int ammount);
 /// Construct a time value from a number of microseconds ( e.g Time x = 100_us; )
 Time operator ""_us(unsigned long long int ammount);
 
+/// Construct a time value from a number of nanoseconds ( e.g Time x = 500_ns; )
+Time operator ""_ns(unsigned long long int ammount);
+
 //==============================================================================
 // OPERATOR OVERLOADS
 //==============================================================================
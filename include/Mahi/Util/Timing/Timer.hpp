@@ -18,6 +18,9 @@
 
 #include <Mahi/Util/Timing/Clock.hpp>
 #include <Mahi/Util/Timing/Frequency.hpp>
+#include <Mahi/Util/Timing/LatencyHistogram.hpp>
+#include <memory>
+#include <string>
 
 namespace mahi {
 namespace util {
@@ -34,11 +37,14 @@ public:
     /// use Busy. On real-time Linux, threads can sleep for much smaller
     /// periods, so Sleep and Hybrid can be used reliably. Generally, using
     /// Hybrid over Sleep will be more accurate since Sleep can go over the
-    /// requested sleep period.
+    /// requested sleep period. Deadline is the most accurate and efficient
+    /// choice on Linux, since deadlines don't drift and the spin margin
+    /// adapts to the platform's measured wakeup latency.
     enum WaitMode {
         Busy,     ///< Waits 100% remaining time using a busy while loop
         Sleep,    ///< Waits 100% remaining time by sleeping the thread
-        Hybrid    ///< Waits x% remaining time using Sleep, then 100-x% using Busy (default x = 90%, set with set_hybrid_percentage())
+        Hybrid,   ///< Waits x% remaining time using Sleep, then 100-x% using Busy (default x = 90%, set with set_hybrid_percentage())
+        Deadline  ///< Sleeps until an absolute deadline minus a self-tuning spin margin, then spins to the deadline
     };
 
 public:
@@ -51,6 +57,12 @@ public:
     /// Destructor
     ~Timer();
 
+    /// Copy constructor (copies recorded statistics)
+    Timer(const Timer& other);
+
+    /// Copy assignment (copies recorded statistics)
+    Timer& operator=(const Timer& other);
+
     /// Sets the Timer wait mode
     void set_wait_mode(WaitMode mode);
 
@@ -91,12 +103,52 @@ public:
     /// Set the percentage of time to sleep for Hybrid timers (default = 0.9)
     void set_hybrid_percentage(double sleep_percent);
 
+    /// Sets the initial spin margin of Deadline timers (default = 100 us).
+    /// The margin then tunes itself from measured wakeup latencies.
+    void set_spin_margin(Time margin);
+
+    /// Gets the current spin margin of Deadline timers
+    Time get_spin_margin() const;
+
+    /// Enables recording the lateness and compute time of every tick into
+    /// fixed-memory histograms (allocated once, here). Off by default.
+    void enable_statistics(bool enable = true);
+
+    /// Returns true if statistics are being recorded
+    bool is_statistics_enabled() const;
+
+    /// Clears recorded statistics (also done by restart())
+    void reset_statistics();
+
+    /// Gets how late each wait() returned relative to its deadline
+    const LatencyHistogram& get_lateness() const;
+
+    /// Gets the time from each wait() returning to the next call to wait(),
+    /// i.e. the time the loop spent computing
+    const LatencyHistogram& get_compute_time() const;
+
+    /// Logs a summary of the recorded statistics
+    void log_statistics() const;
+
+    /// Saves a summary of the recorded statistics to a CSV file
+    bool save_statistics(const std::string& filepath) const;
+
     /// Enable deadline miss warnings
     void enable_warnings();
 
     /// Disable deadline miss warnings
     void disable_warnings();
 
+protected:
+    /// Waits for the remaining period (Busy, Sleep and Hybrid modes)
+    Time wait_relative();
+
+    /// Waits until the next absolute deadline (Deadline mode)
+    Time wait_deadline();
+
+    /// Updates the spin margin from a measured wakeup latency [ns]
+    void tune_spin_margin(int64 latency, int64 period);
+
 protected:
     WaitMode mode_;      ///< the Timer's waiting mode
     Clock clock_;        ///< the Timer's internal clock
@@ -108,6 +160,18 @@ protected:
     double rate_;        ///< acceptable miss rate
     double hybrid_perc_; ///< percentage of time slept in hybrid mode (default = 0.9)
     bool warnings_;      ///< emit warnings?
+    int64 deadline_ns_;  ///< next absolute deadline in Deadline mode [ns]
+    int64 spin_ns_;      ///< spin margin before the deadline in Deadline mode [ns]
+    double latency_mean_;///< average wakeup latency in Deadline mode [ns]
+    double latency_dev_; ///< average deviation of wakeup latency in Deadline mode [ns]
+
+    /// Per-tick statistics
+    struct Statistics {
+        LatencyHistogram lateness;     ///< lateness of each tick
+        LatencyHistogram compute_time; ///< compute time of each tick
+        int64 last_return_ns;          ///< time wait() last returned [ns]
+    };
+    std::unique_ptr<Statistics> stats_; ///< per-tick statistics (null if disabled)
 };
 
 } // namespace util
@@ -15,6 +15,7 @@
 // Author(s): Evan Pezent (epezent@rice.edu)
 
 #pragma once
+#include <Mahi/Util/Types.hpp>
 #include <string>
 
 namespace mahi {
@@ -23,8 +24,27 @@ namespace util {
 /// Encapsulates a timestamp
 class Timestamp {
 public:
-    /// Default constructor
+    /// Wall clock used to read the current time
+    enum Source {
+        Realtime,       ///< full resolution system time
+        RealtimeCoarse  ///< cheaper system time updated every scheduler tick (Linux only)
+    };
+
+    /// Maximum number of chars written by the write_ functions
+    static const std::size_t MaxSize = 32;
+
+public:
+    /// Default constructor (reads the Realtime clock)
     Timestamp();
+
+    /// Constructs a Timestamp of the current time read from source
+    explicit Timestamp(Source source);
+
+    /// Constructs a Timestamp from a number of microseconds since the Unix epoch
+    explicit Timestamp(int64 epoch_us);
+
+    /// Returns the current time as a number of microseconds since the Unix epoch
+    static int64 epoch_microseconds(Source source = Realtime);
     
     /// Returns timestamp string as "yyyy-mm-dd"
     std::string yyyy_mm_dd() const;
@@ -32,12 +52,24 @@ public:
     /// Returns timestamp as "hh:mm:ss.mmm"
     std::string hh_mm_ss_mmm() const;
 
-    /// Returns timestamp as "yyyy-mm-dd_hh:mm:ss"
+    /// Returns timestamp as "yyyy-mm-dd_hh.mm.ss"
     std::string yyyy_mm_dd_hh_mm_ss() const;
 
-    /// Returns timestamp as "yyyy-mm-dd_hh:mm:ss.mmm"
+    /// Returns timestamp as "yyyy-mm-dd hh:mm:ss.mmm"
     std::string yyyy_mm_dd_hh_mm_ss_mmm() const;
 
+    /// Writes "yyyy-mm-dd" to buffer and returns the end of the written chars (not null terminated)
+    char* write_yyyy_mm_dd(char* buffer) const;
+
+    /// Writes "hh:mm:ss.mmm" to buffer and returns the end of the written chars (not null terminated)
+    char* write_hh_mm_ss_mmm(char* buffer) const;
+
+    /// Writes "yyyy-mm-dd_hh.mm.ss" to buffer and returns the end of the written chars (not null terminated)
+    char* write_yyyy_mm_dd_hh_mm_ss(char* buffer) const;
+
+    /// Writes "yyyy-mm-dd hh:mm:ss.mmm" to buffer and returns the end of the written chars (not null terminated)
+    char* write_yyyy_mm_dd_hh_mm_ss_mmm(char* buffer) const;
+
 public:
     int year;      ///< year
     int month;     ///< month                    [1-12]
@@ -0,0 +1,86 @@
+#include <Mahi/Util/Concurrency/ThreadPool.hpp>
+
+namespace mahi {
+namespace util {
+
+ThreadPool::ThreadPool(std::size_t threads) :
+    task_(nullptr),
+    count_(0),
+    next_(0),
+    pending_(0),
+    generation_(0),
+    stop_(false)
+{
+    if (threads == 0)
+        threads = hardware_threads();
+    for (std::size_t i = 1; i < threads; ++i)
+        workers_.push_back(std::thread(&ThreadPool::run, this));
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    start_.notify_all();
+    for (std::size_t i = 0; i < workers_.size(); ++i)
+        workers_[i].join();
+}
+
+std::size_t ThreadPool::size() const {
+    return workers_.size() + 1;
+}
+
+std::size_t ThreadPool::hardware_threads() {
+    unsigned int n = std::thread::hardware_concurrency();
+    return n > 0 ? n : 1;
+}
+
+void ThreadPool::parallel_for(std::size_t count, const std::function<void(std::size_t)>& task) {
+    if (count == 0)
+        return;
+    if (workers_.empty() || count == 1) {
+        for (std::size_t i = 0; i < count; ++i)
+            task(i);
+        return;
+    }
+    std::lock_guard<std::mutex> call_lock(call_mutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_    = &task;
+        count_   = count;
+        next_.store(0);
+        pending_ = workers_.size();
+        generation_++;
+    }
+    start_.notify_all();
+    work();
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this]() { return pending_ == 0; });
+    task_ = nullptr;
+}
+
+void ThreadPool::work() {
+    for (std::size_t i = next_.fetch_add(1); i < count_; i = next_.fetch_add(1))
+        (*task_)(i);
+}
+
+void ThreadPool::run() {
+    std::size_t generation = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_.wait(lock, [&]() { return stop_ || generation_ != generation; });
+            if (stop_)
+                return;
+            generation = generation_;
+        }
+        work();
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--pending_ == 0)
+            done_.notify_one();
+    }
+}
+
+} // namespace util
+} // namespace mahi
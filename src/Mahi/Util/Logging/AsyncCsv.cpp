@@ -0,0 +1,204 @@
+#include <Mahi/Util/Logging/AsyncCsv.hpp>
+#include <Mahi/Util/Logging/Log.hpp>
+#include <Mahi/Util/System.hpp>
+#include <Mahi/Util/Timing/Clock.hpp>
+#include <algorithm>
+
+namespace mahi {
+namespace util {
+
+AsyncCsv::AsyncCsv() :
+    columns_(0),
+    running_(false),
+    dropped_(0),
+    high_water_(0),
+    format_ns_(0),
+    write_ns_(0),
+    written_(0),
+    head_(0),
+    tail_(0)
+{}
+
+AsyncCsv::AsyncCsv(const std::string& filepath, const std::vector<std::string>& header,
+                   const AsyncCsvOptions& options, WriteMode w_mode, OpenMode o_mode) :
+    AsyncCsv()
+{
+    open(filepath, header, options, w_mode, o_mode);
+}
+
+AsyncCsv::~AsyncCsv() {
+    close();
+}
+
+bool AsyncCsv::open(const std::string& filepath, const std::vector<std::string>& header,
+                    const AsyncCsvOptions& options, WriteMode w_mode, OpenMode o_mode)
+{
+    return start(filepath, header.size(), &header, options, w_mode, o_mode);
+}
+
+bool AsyncCsv::open(const std::string& filepath, std::size_t columns,
+                    const AsyncCsvOptions& options, WriteMode w_mode, OpenMode o_mode)
+{
+    return start(filepath, columns, nullptr, options, w_mode, o_mode);
+}
+
+bool AsyncCsv::start(const std::string& filepath, std::size_t columns, const std::vector<std::string>* header,
+                     const AsyncCsvOptions& options, WriteMode w_mode, OpenMode o_mode)
+{
+    close();
+    if (columns == 0 || options.capacity == 0) {
+        LOG(Error) << "AsyncCsv requires at least one column and a nonzero capacity";
+        return false;
+    }
+    if (!file_.open(filepath, w_mode, o_mode))
+        return false;
+    options_ = options;
+    columns_ = columns;
+    // preallocate and touch the ring so the caller never page faults on it
+    ring_.assign(options_.capacity * columns_, 0.0);
+    buffer_.clear();
+    buffer_.reserve(options_.buffer_size);
+    if (header) {
+        for (std::size_t j = 0; j < header->size(); ++j) {
+            if (j > 0)
+                buffer_.push_back(',');
+            buffer_.append((*header)[j].data(), (*header)[j].data() + (*header)[j].size());
+        }
+        buffer_.push_back('\n');
+    }
+    dropped_.store(0);
+    high_water_.store(0);
+    format_ns_.store(0);
+    write_ns_.store(0);
+    written_.store(0);
+    head_.store(0);
+    tail_.store(0);
+    running_.store(true, std::memory_order_release);
+    writer_ = std::thread(&AsyncCsv::run, this);
+    return true;
+}
+
+double* AsyncCsv::reserve_row() {
+    const uint64 head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) >= options_.capacity) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    return &ring_[static_cast<std::size_t>(head % options_.capacity) * columns_];
+}
+
+void AsyncCsv::commit_row() {
+    const uint64 head   = head_.load(std::memory_order_relaxed) + 1;
+    head_.store(head, std::memory_order_release);
+    // only this thread raises the high water mark
+    const std::size_t queued = static_cast<std::size_t>(head - tail_.load(std::memory_order_relaxed));
+    if (queued > high_water_.load(std::memory_order_relaxed))
+        high_water_.store(queued, std::memory_order_relaxed);
+}
+
+bool AsyncCsv::reject_row(std::size_t count) const {
+    if (!is_open()) {
+        LOG(Error) << "AsyncCsv is not open";
+    }
+    else {
+        LOG(Error) << "AsyncCsv row has " << count << " values but the file has " << columns_ << " columns";
+    }
+    return false;
+}
+
+bool AsyncCsv::write_values(const double* values) {
+    if (!is_open())
+        return reject_row(0);
+    double* slot = reserve_row();
+    if (!slot)
+        return false;
+    std::copy(values, values + columns_, slot);
+    commit_row();
+    return true;
+}
+
+void AsyncCsv::run() {
+    const detail::CsvFormat format(options_.format, static_cast<int>(options_.precision));
+    Clock clock;
+    for (;;) {
+        // read running_ before head_ so that rows queued before close() are drained
+        const bool running = running_.load(std::memory_order_acquire);
+        const uint64 head  = head_.load(std::memory_order_acquire);
+        uint64 tail        = tail_.load(std::memory_order_relaxed);
+        if (tail == head) {
+            write_buffer();
+            if (!running)
+                break;
+            sleep(options_.poll_period);
+            continue;
+        }
+        clock.restart();
+        for (; tail != head; ++tail) {
+            const double* row = &ring_[static_cast<std::size_t>(tail % options_.capacity) * columns_];
+            for (std::size_t j = 0; j < columns_; ++j) {
+                if (j > 0)
+                    buffer_.push_back(',');
+                detail::csv_write_field(buffer_, row[j], format);
+            }
+            buffer_.push_back('\n');
+            if (buffer_.size() >= options_.buffer_size) {
+                tail_.store(tail + 1, std::memory_order_release);
+                format_ns_.fetch_add(clock.get_elapsed_time().as_nanoseconds(), std::memory_order_relaxed);
+                write_buffer();
+                clock.restart();
+            }
+        }
+        tail_.store(tail, std::memory_order_release);
+        format_ns_.fetch_add(clock.get_elapsed_time().as_nanoseconds(), std::memory_order_relaxed);
+    }
+}
+
+void AsyncCsv::write_buffer() {
+    if (buffer_.size() == 0)
+        return;
+    Clock clock;
+    file_.write(buffer_.data(), buffer_.size());
+    buffer_.clear();
+    write_ns_.fetch_add(clock.get_elapsed_time().as_nanoseconds(), std::memory_order_relaxed);
+    written_.store(tail_.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+void AsyncCsv::flush() {
+    if (!writer_.joinable())
+        return;
+    const uint64 head = head_.load(std::memory_order_acquire);
+    while (written_.load(std::memory_order_acquire) < head)
+        sleep(options_.poll_period);
+}
+
+void AsyncCsv::close() {
+    if (writer_.joinable()) {
+        running_.store(false, std::memory_order_release);
+        writer_.join();
+    }
+    file_.close();
+    std::vector<double>().swap(ring_);
+    columns_ = 0;
+}
+
+bool AsyncCsv::is_open() const {
+    return file_.is_open();
+}
+
+std::size_t AsyncCsv::column_count() const {
+    return columns_;
+}
+
+AsyncCsvStats AsyncCsv::get_stats() const {
+    AsyncCsvStats stats;
+    stats.rows_written    = written_.load(std::memory_order_acquire);
+    stats.rows_dropped    = dropped_.load(std::memory_order_relaxed);
+    stats.high_water_mark = high_water_.load(std::memory_order_relaxed);
+    stats.capacity        = options_.capacity;
+    stats.format_time     = nanoseconds(format_ns_.load(std::memory_order_relaxed));
+    stats.write_time      = nanoseconds(write_ns_.load(std::memory_order_relaxed));
+    return stats;
+}
+
+} // namespace util
+} // namespace mahi
@@ -0,0 +1,468 @@
+#include <Mahi/Util/Logging/BinaryLog.hpp>
+#include <Mahi/Util/System.hpp>
+#include <fmt/format.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <unordered_map>
+
+namespace mahi {
+namespace util {
+
+//==============================================================================
+// FILE FORMAT
+//==============================================================================
+//
+// All values are stored in native byte order (flagged in the header).
+//
+// session header : "MAHIBLOG" | uint32 version | uint32 flags
+// site entry     : 'S' | uint32 id | uint8 severity | uint32 line |
+//                  str func | str file | str format | uint8 nargs | uint8 types[nargs]
+// record entry   : 'R' | uint32 id | int64 epoch_us | uint32 tid | args...
+//
+// where str is a uint16 length followed by that many chars
+
+namespace {
+
+    const char   BLOG_MAGIC[8]   = {'M', 'A', 'H', 'I', 'B', 'L', 'O', 'G'};
+    const uint32 BLOG_VERSION    = 1;
+    const uint32 BLOG_LITTLE_END = 1;
+
+    uint32 native_flags() {
+        const uint16 one = 1;
+        return *reinterpret_cast<const uint8*>(&one) == 1 ? BLOG_LITTLE_END : 0;
+    }
+
+    /// Global call site registry
+    struct SiteRegistry {
+        Mutex mutex;
+        std::deque<BinaryLogSite> sites;
+    };
+
+    SiteRegistry& get_registry() {
+        static SiteRegistry registry;
+        return registry;
+    }
+
+} // namespace
+
+uint32 register_binary_log_site(Severity severity, const char* func, size_t line,
+                                const char* file, const char* format,
+                                const uint8* types, std::size_t count)
+{
+    SiteRegistry& registry = get_registry();
+    Lock lock(registry.mutex);
+    BinaryLogSite site;
+    site.id       = static_cast<uint32>(registry.sites.size());
+    site.severity = severity;
+    site.func     = func;
+    site.line     = line;
+    site.file     = file;
+    site.format   = format;
+    site.types.assign(types, types + count);
+    registry.sites.push_back(site);
+    return site.id;
+}
+
+BinaryLogSite get_binary_log_site(uint32 id) {
+    SiteRegistry& registry = get_registry();
+    Lock lock(registry.mutex);
+    return registry.sites.at(id);
+}
+
+namespace detail {
+
+uint32 blog_thread_id() {
+    static thread_local uint32 tid = get_thread_id();
+    return tid;
+}
+
+} // namespace detail
+
+//==============================================================================
+// BINARY LOG WRITER
+//==============================================================================
+
+BinaryLogWriter::BinaryLogWriter(const std::string& filename,
+                                 size_t max_file_size,
+                                 int max_files,
+                                 Severity max_severity,
+                                 std::size_t buffer_size) :
+    file_size_(0),
+    max_file_size_((std::max)(static_cast<off_t>(max_file_size), static_cast<off_t>(1000))),
+    last_file_number_((std::max)(max_files - 1, 0)),
+    first_write_(true),
+    max_severity_(max_severity),
+    buffer_((std::max)(buffer_size, static_cast<std::size_t>(1024))),
+    used_(0)
+{
+    split_filename(filename, filename_no_ext_, file_ext_);
+}
+
+BinaryLogWriter::~BinaryLogWriter() {
+    flush();
+}
+
+void BinaryLogWriter::flush() {
+    Lock lock(mutex_);
+    write_buffer();
+}
+
+char* BinaryLogWriter::begin_record(uint32 site, std::size_t size) {
+    if (first_write_) {
+        open_log_file();
+        first_write_ = false;
+    }
+    else if (last_file_number_ > 0 && file_size_ > max_file_size_) {
+        roll_log_files();
+    }
+    if (site >= emitted_.size())
+        emitted_.resize(site + 1, false);
+    if (!emitted_[site])
+        write_site(site);
+    if (used_ + size > buffer_.size()) {
+        write_buffer();
+        if (size > buffer_.size())
+            buffer_.resize(size);
+    }
+    return buffer_.data() + used_;
+}
+
+void BinaryLogWriter::append(const void* data, std::size_t size) {
+    if (used_ + size > buffer_.size()) {
+        write_buffer();
+        if (size > buffer_.size())
+            buffer_.resize(size);
+    }
+    std::memcpy(buffer_.data() + used_, data, size);
+    used_ += size;
+    file_size_ += static_cast<off_t>(size);
+}
+
+void BinaryLogWriter::write_buffer() {
+    if (used_ > 0 && file_.write(buffer_.data(), used_) < 0) {
+        LOG(Error) << "Failed to write binary log " << build_file_name();
+    }
+    used_ = 0;
+}
+
+void BinaryLogWriter::write_session_header() {
+    const uint32 version = BLOG_VERSION;
+    const uint32 flags   = native_flags();
+    append(BLOG_MAGIC, sizeof(BLOG_MAGIC));
+    append(&version, sizeof(version));
+    append(&flags, sizeof(flags));
+    emitted_.assign(emitted_.size(), false);
+}
+
+void BinaryLogWriter::write_site(uint32 id) {
+    BinaryLogSite site = get_binary_log_site(id);
+    const char* strings[3] = {site.func, site.file, site.format};
+    std::size_t size = 1 + 4 + 1 + 4 + 1 + site.types.size();
+    for (int i = 0; i < 3; ++i)
+        size += 2 + detail::BlogStringArg::length(strings[i], std::strlen(strings[i]));
+    std::vector<char> entry(size);
+    char* p = entry.data();
+    p = detail::blog_put(p, static_cast<uint8>('S'));
+    p = detail::blog_put(p, site.id);
+    p = detail::blog_put(p, static_cast<uint8>(site.severity));
+    p = detail::blog_put(p, static_cast<uint32>(site.line));
+    for (int i = 0; i < 3; ++i)
+        p = detail::BlogStringArg::encode(p, strings[i], std::strlen(strings[i]));
+    p = detail::blog_put(p, static_cast<uint8>(site.types.size()));
+    if (!site.types.empty())
+        std::memcpy(p, site.types.data(), site.types.size());
+    append(entry.data(), entry.size());
+    emitted_[id] = true;
+}
+
+void BinaryLogWriter::open_log_file() {
+    std::string filename = build_file_name();
+    file_.open(filename, WriteMode::Append);
+    struct stat info;
+    file_size_ = ::stat(filename.c_str(), &info) == 0 ? static_cast<off_t>(info.st_size) : 0;
+    write_session_header();
+}
+
+void BinaryLogWriter::roll_log_files() {
+    write_buffer();
+    file_.close();
+    File::unlink(build_file_name(last_file_number_));
+    for (int file_number = last_file_number_ - 1; file_number >= 0; --file_number)
+        File::rename(build_file_name(file_number), build_file_name(file_number + 1));
+    open_log_file();
+}
+
+std::string BinaryLogWriter::build_file_name(int file_number) {
+    std::ostringstream ss;
+    ss << filename_no_ext_;
+    if (file_number > 0)
+        ss << '.' << file_number;
+    if (!file_ext_.empty())
+        ss << '.' << file_ext_;
+    return ss.str();
+}
+
+//==============================================================================
+// DECODING
+//==============================================================================
+
+namespace {
+
+    /// Call site read back from a file
+    struct DecodedSite {
+        Severity severity;
+        uint32 line;
+        std::string func;
+        std::string file;
+        std::string format;
+        std::vector<uint8> types;
+    };
+
+    /// Argument value read back from a file
+    struct DecodedArg {
+        uint8 type;
+        int64 i;
+        uint64 u;
+        double f;
+        std::string s;
+    };
+
+    /// Bounds checked sequential reader over the file contents
+    class BlogReader {
+    public:
+        BlogReader(const std::vector<char>& data) : p_(data.data()), end_(data.data() + data.size()) {}
+
+        bool done() const { return p_ == end_; }
+
+        std::size_t remaining() const { return static_cast<std::size_t>(end_ - p_); }
+
+        const char* position() const { return p_; }
+
+        template <typename T>
+        bool get(T& value) {
+            if (remaining() < sizeof(T))
+                return false;
+            std::memcpy(&value, p_, sizeof(T));
+            p_ += sizeof(T);
+            return true;
+        }
+
+        bool get(std::string& value) {
+            uint16 length;
+            if (!get(length) || remaining() < length)
+                return false;
+            value.assign(p_, length);
+            p_ += length;
+            return true;
+        }
+
+        bool skip(std::size_t n) {
+            if (remaining() < n)
+                return false;
+            p_ += n;
+            return true;
+        }
+
+    private:
+        const char* p_;
+        const char* end_;
+    };
+
+    template <typename T>
+    bool get_as(BlogReader& reader, DecodedArg& arg) {
+        T value;
+        if (!reader.get(value))
+            return false;
+        if (std::is_floating_point<T>::value)
+            arg.f = static_cast<double>(value);
+        else if (std::is_signed<T>::value)
+            arg.i = static_cast<int64>(value);
+        else
+            arg.u = static_cast<uint64>(value);
+        return true;
+    }
+
+    bool get_arg(BlogReader& reader, uint8 type, DecodedArg& arg) {
+        arg.type = type;
+        switch (type) {
+            case BlogBool:
+            case BlogUInt8:   return get_as<uint8>(reader, arg);
+            case BlogChar:
+            case BlogInt8:    return get_as<int8>(reader, arg);
+            case BlogInt16:   return get_as<int16>(reader, arg);
+            case BlogInt32:   return get_as<int32>(reader, arg);
+            case BlogInt64:   return get_as<int64>(reader, arg);
+            case BlogUInt16:  return get_as<uint16>(reader, arg);
+            case BlogUInt32:  return get_as<uint32>(reader, arg);
+            case BlogUInt64:  return get_as<uint64>(reader, arg);
+            case BlogFloat32: return get_as<float>(reader, arg);
+            case BlogFloat64: return get_as<double>(reader, arg);
+            case BlogString:  return reader.get(arg.s);
+            default:          return false;
+        }
+    }
+
+    /// Formats a single argument with a single replacement field (e.g. "{:.3f}")
+    std::string format_arg(const std::string& field, const DecodedArg& arg) {
+        switch (arg.type) {
+            case BlogBool:    return fmt::format(field, arg.u != 0);
+            case BlogChar:    return fmt::format(field, static_cast<char>(arg.i));
+            case BlogInt8:
+            case BlogInt16:
+            case BlogInt32:
+            case BlogInt64:   return fmt::format(field, arg.i);
+            case BlogUInt8:
+            case BlogUInt16:
+            case BlogUInt32:
+            case BlogUInt64:  return fmt::format(field, arg.u);
+            case BlogFloat32: return fmt::format(field, static_cast<float>(arg.f));
+            case BlogFloat64: return fmt::format(field, arg.f);
+            default:          return fmt::format(field, arg.s);
+        }
+    }
+
+    /// Renders a format string by formatting each replacement field on its own
+    void render_message(const std::string& format, const std::vector<DecodedArg>& args,
+                        LogRecord& record)
+    {
+        std::size_t next = 0, i = 0;
+        while (i < format.size()) {
+            char c = format[i];
+            if ((c == '{' || c == '}') && i + 1 < format.size() && format[i + 1] == c) {
+                record.append(&c, 1);
+                i += 2;
+                continue;
+            }
+            if (c != '{') {
+                record.append(&c, 1);
+                ++i;
+                continue;
+            }
+            std::size_t close = format.find('}', i);
+            if (close == std::string::npos) {
+                record.append(format.data() + i, format.size() - i);
+                break;
+            }
+            std::string original = format.substr(i, close - i + 1);
+            std::string field    = original;
+            i = close + 1;
+            // strip an explicit argument index (e.g. "{1:.2f}" -> "{:.2f}")
+            std::size_t digits = 1;
+            while (digits < field.size() && field[digits] >= '0' && field[digits] <= '9')
+                ++digits;
+            std::size_t index;
+            if (digits > 1) {
+                index = static_cast<std::size_t>(std::stoul(field.substr(1, digits - 1)));
+                field.erase(1, digits - 1);
+            }
+            else {
+                index = next++;
+            }
+            std::string formatted;
+            if (index < args.size()) {
+                try {
+                    formatted = format_arg(field, args[index]);
+                }
+                catch (const fmt::format_error&) {
+                    formatted = original;
+                }
+            }
+            else {
+                formatted = original;
+            }
+            record.append(formatted.data(), formatted.size());
+        }
+    }
+
+} // namespace
+
+bool decode_binary_log(const std::string& filepath,
+                       const std::function<void(const LogRecord&)>& callback)
+{
+    std::ifstream in(filepath.c_str(), std::ios::binary);
+    if (!in.is_open()) {
+        LOG(Error) << "Failed to open binary log: " << filepath;
+        return false;
+    }
+    std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    BlogReader reader(data);
+    std::unordered_map<uint32, DecodedSite> sites;
+    std::vector<DecodedArg> args;
+    bool session = false;
+    while (!reader.done()) {
+        const char* entry = reader.position();
+        if (reader.remaining() >= sizeof(BLOG_MAGIC) &&
+            std::memcmp(entry, BLOG_MAGIC, sizeof(BLOG_MAGIC)) == 0)
+        {
+            uint32 version, flags;
+            reader.skip(sizeof(BLOG_MAGIC));
+            if (!reader.get(version) || !reader.get(flags))
+                break;
+            if (version != BLOG_VERSION || flags != native_flags()) {
+                LOG(Error) << "Unsupported binary log version/byte order in " << filepath;
+                return false;
+            }
+            sites.clear();
+            session = true;
+            continue;
+        }
+        uint8 kind;
+        reader.get(kind);
+        if (!session) {
+            LOG(Error) << "Not a binary log: " << filepath;
+            return false;
+        }
+        if (kind == 'S') {
+            uint32 id;
+            uint8 severity, nargs;
+            DecodedSite site;
+            if (!reader.get(id) || !reader.get(severity) || !reader.get(site.line) ||
+                !reader.get(site.func) || !reader.get(site.file) || !reader.get(site.format) ||
+                !reader.get(nargs) || reader.remaining() < nargs)
+                break;
+            site.severity = static_cast<Severity>(severity);
+            site.types.assign(reader.position(), reader.position() + nargs);
+            reader.skip(nargs);
+            sites[id] = site;
+        }
+        else if (kind == 'R') {
+            uint32 id, tid;
+            int64 time;
+            if (!reader.get(id) || !reader.get(time) || !reader.get(tid))
+                break;
+            auto it = sites.find(id);
+            if (it == sites.end()) {
+                LOG(Error) << "Binary log record references unknown site " << id << " in " << filepath;
+                return false;
+            }
+            const DecodedSite& site = it->second;
+            args.resize(site.types.size());
+            bool complete = true;
+            for (std::size_t a = 0; a < site.types.size() && complete; ++a)
+                complete = get_arg(reader, site.types[a], args[a]);
+            if (!complete)
+                break;
+            LogRecord record(site.severity, site.func.c_str(), site.line, site.file.c_str(),
+                             Timestamp(time), tid);
+            render_message(site.format, args, record);
+            callback(record);
+        }
+        else {
+            LOG(Error) << "Corrupt binary log entry at offset " << (entry - data.data())
+                       << " in " << filepath;
+            return false;
+        }
+    }
+    if (!reader.done()) {
+        LOG(Warning) << "Binary log " << filepath << " ends with a truncated entry";
+    }
+    return true;
+}
+
+} // namespace util
+} // namespace mahi
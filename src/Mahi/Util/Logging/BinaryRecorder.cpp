@@ -0,0 +1,423 @@
+#include <Mahi/Util/Logging/BinaryRecorder.hpp>
+#include <Mahi/Util/Logging/Log.hpp>
+#include <Mahi/Util/System.hpp>
+
+namespace mahi {
+namespace util {
+
+namespace {
+
+    const char   RECORDING_MAGIC[8]   = {'M', 'A', 'H', 'I', 'B', 'R', 'E', 'C'};
+    const uint32 RECORDING_VERSION    = 2;
+    const uint32 RECORDING_LITTLE_END = 1;
+
+    /// Returns the header flags of recordings written on this machine
+    uint32 native_flags() {
+        const uint16 one = 1;
+        return *reinterpret_cast<const uint8*>(&one) == 1 ? RECORDING_LITTLE_END : 0;
+    }
+
+    inline std::size_t pad8(std::size_t size) {
+        return (size + 7) & ~static_cast<std::size_t>(7);
+    }
+
+    /// Returns the size of a chunk of rows with the given value sizes
+    std::size_t chunk_size(const std::vector<std::size_t>& sizes, std::size_t rows) {
+        std::size_t size = sizeof(uint64);
+        for (std::size_t j = 0; j < sizes.size(); ++j)
+            size += pad8(rows * sizes[j]);
+        return size;
+    }
+
+} // namespace
+
+std::size_t record_type_size(RecordType type) {
+    switch (type) {
+        case RecordInt8:    return 1;
+        case RecordInt16:   return 2;
+        case RecordInt32:   return 4;
+        case RecordInt64:   return 8;
+        case RecordUInt8:   return 1;
+        case RecordUInt16:  return 2;
+        case RecordUInt32:  return 4;
+        case RecordUInt64:  return 8;
+        case RecordFloat32: return 4;
+        case RecordFloat64: return 8;
+    }
+    return 0;
+}
+
+const char* record_type_name(RecordType type) {
+    switch (type) {
+        case RecordInt8:    return "int8";
+        case RecordInt16:   return "int16";
+        case RecordInt32:   return "int32";
+        case RecordInt64:   return "int64";
+        case RecordUInt8:   return "uint8";
+        case RecordUInt16:  return "uint16";
+        case RecordUInt32:  return "uint32";
+        case RecordUInt64:  return "uint64";
+        case RecordFloat32: return "float32";
+        case RecordFloat64: return "float64";
+    }
+    return "invalid";
+}
+
+//==============================================================================
+// RECORDER
+//==============================================================================
+
+BinaryRecorder::BinaryRecorder() :
+    chunk_rows_(0),
+    buffered_(0),
+    rows_(0)
+{}
+
+BinaryRecorder::BinaryRecorder(const std::string& filepath, const std::vector<RecordColumn>& schema, std::size_t chunk_rows) :
+    BinaryRecorder()
+{
+    open(filepath, schema, chunk_rows);
+}
+
+BinaryRecorder::~BinaryRecorder() {
+    close();
+}
+
+bool BinaryRecorder::open(const std::string& filepath, const std::vector<RecordColumn>& schema, std::size_t chunk_rows) {
+    close();
+    if (schema.empty()) {
+        LOG(Error) << "BinaryRecorder schema must have at least one column";
+        return false;
+    }
+    for (std::size_t j = 0; j < schema.size(); ++j) {
+        if (record_type_size(schema[j].type) == 0 || schema[j].name.size() > 0xFFFF) {
+            LOG(Error) << "Invalid BinaryRecorder column: " << schema[j].name;
+            return false;
+        }
+    }
+    if (!file_.open(filepath, WriteMode::Truncate))
+        return false;
+
+    // header
+    std::vector<char> header(RECORDING_MAGIC, RECORDING_MAGIC + sizeof(RECORDING_MAGIC));
+    const uint32 version = RECORDING_VERSION;
+    const uint32 flags   = native_flags();
+    const uint32 columns = static_cast<uint32>(schema.size());
+    const uint64 rows    = static_cast<uint64>(chunk_rows > 0 ? chunk_rows : 1);
+    header.insert(header.end(), reinterpret_cast<const char*>(&version), reinterpret_cast<const char*>(&version + 1));
+    header.insert(header.end(), reinterpret_cast<const char*>(&flags), reinterpret_cast<const char*>(&flags + 1));
+    header.insert(header.end(), reinterpret_cast<const char*>(&columns), reinterpret_cast<const char*>(&columns + 1));
+    header.insert(header.end(), reinterpret_cast<const char*>(&rows), reinterpret_cast<const char*>(&rows + 1));
+    for (std::size_t j = 0; j < schema.size(); ++j) {
+        const uint16 name_size = static_cast<uint16>(schema[j].name.size());
+        header.push_back(static_cast<char>(schema[j].type));
+        header.push_back(0);
+        header.insert(header.end(), reinterpret_cast<const char*>(&name_size), reinterpret_cast<const char*>(&name_size + 1));
+        header.insert(header.end(), schema[j].name.begin(), schema[j].name.end());
+    }
+    header.resize(pad8(header.size()), 0);
+    if (file_.write(header.data(), header.size()) != static_cast<int>(header.size())) {
+        LOG(Error) << "Failed to write BinaryRecorder header: " << filepath;
+        file_.close();
+        return false;
+    }
+
+    // chunk buffer: uint64 rows followed by one block per column
+    schema_     = schema;
+    chunk_rows_ = static_cast<std::size_t>(rows);
+    sizes_.resize(schema_.size());
+    offsets_.resize(schema_.size());
+    std::size_t offset = sizeof(uint64);
+    for (std::size_t j = 0; j < schema_.size(); ++j) {
+        sizes_[j]   = record_type_size(schema_[j].type);
+        offsets_[j] = offset;
+        offset     += pad8(chunk_rows_ * sizes_[j]);
+    }
+    chunk_.assign(offset, 0);
+    buffered_ = 0;
+    rows_     = 0;
+    return true;
+}
+
+bool BinaryRecorder::check_row(std::size_t count) const {
+    if (!file_.is_open()) {
+        LOG(Error) << "BinaryRecorder is not open";
+        return false;
+    }
+    if (count != schema_.size()) {
+        LOG(Error) << "BinaryRecorder row has " << count << " values but the schema has " << schema_.size() << " columns";
+        return false;
+    }
+    return true;
+}
+
+bool BinaryRecorder::commit_row() {
+    rows_++;
+    if (++buffered_ == chunk_rows_)
+        return write_chunk();
+    return true;
+}
+
+bool BinaryRecorder::write_chunk() {
+    if (buffered_ == 0)
+        return true;
+    const uint64 rows = static_cast<uint64>(buffered_);
+    std::memcpy(chunk_.data(), &rows, sizeof(rows));
+    bool ok = true;
+    if (buffered_ == chunk_rows_) {
+        // full chunk: the buffer already has the file layout
+        ok = file_.write(chunk_.data(), chunk_.size()) == static_cast<int>(chunk_.size());
+    }
+    else {
+        // partial chunk: compact the column blocks to the rows buffered
+        std::size_t size = sizeof(uint64);
+        for (std::size_t j = 0; j < schema_.size(); ++j) {
+            std::size_t block = buffered_ * sizes_[j];
+            std::memmove(&chunk_[size], &chunk_[offsets_[j]], block);
+            std::memset(&chunk_[size + block], 0, pad8(block) - block);
+            size += pad8(block);
+        }
+        ok = file_.write(chunk_.data(), size) == static_cast<int>(size);
+    }
+    buffered_ = 0;
+    if (!ok) {
+        LOG(Error) << "Failed to write BinaryRecorder chunk";
+    }
+    return ok;
+}
+
+bool BinaryRecorder::flush() {
+    if (!file_.is_open())
+        return false;
+    return write_chunk();
+}
+
+void BinaryRecorder::close() {
+    if (!file_.is_open())
+        return;
+    write_chunk();
+    file_.close();
+}
+
+bool BinaryRecorder::is_open() const {
+    return file_.is_open();
+}
+
+uint64 BinaryRecorder::rows() const {
+    return rows_;
+}
+
+const std::vector<RecordColumn>& BinaryRecorder::schema() const {
+    return schema_;
+}
+
+//==============================================================================
+// READER
+//==============================================================================
+
+BinaryRecordingReader::BinaryRecordingReader() :
+    row_count_(0)
+{}
+
+BinaryRecordingReader::BinaryRecordingReader(const std::string& filepath) :
+    BinaryRecordingReader()
+{
+    open(filepath);
+}
+
+bool BinaryRecordingReader::open(const std::string& filepath) {
+    close();
+    std::string directory, filename, ext, full;
+    if (!parse_filepath(filepath, directory, filename, ext, full)) {
+        LOG(Error) << "Failed to parse filepath: " << filepath;
+        return false;
+    }
+    if (!mapping_.open(full))
+        return false;
+
+    const char* p   = mapping_.data();
+    const char* end = p + mapping_.size();
+    uint32 version, flags, columns;
+    uint64 chunk_rows;
+    const std::size_t fixed = sizeof(RECORDING_MAGIC) + sizeof(version) + sizeof(flags) + sizeof(columns) + sizeof(chunk_rows);
+    if (mapping_.size() < fixed || std::memcmp(p, RECORDING_MAGIC, sizeof(RECORDING_MAGIC)) != 0) {
+        LOG(Error) << "Not a BinaryRecorder file: " << full;
+        close();
+        return false;
+    }
+    p += sizeof(RECORDING_MAGIC);
+    std::memcpy(&version, p, sizeof(version));       p += sizeof(version);
+    std::memcpy(&flags, p, sizeof(flags));           p += sizeof(flags);
+    std::memcpy(&columns, p, sizeof(columns));       p += sizeof(columns);
+    std::memcpy(&chunk_rows, p, sizeof(chunk_rows)); p += sizeof(chunk_rows);
+    if (version != RECORDING_VERSION) {
+        LOG(Error) << "Unsupported BinaryRecorder version " << version << ": " << full;
+        close();
+        return false;
+    }
+    if (flags != native_flags()) {
+        LOG(Error) << "BinaryRecorder file was written with a different byte order: " << full;
+        close();
+        return false;
+    }
+
+    // schema (each column takes at least 4 bytes, so a corrupt count can't
+    // make us allocate more than the file could describe)
+    if (columns == 0 || columns > static_cast<std::size_t>(end - p) / 4) {
+        LOG(Error) << "Invalid BinaryRecorder header (" << columns << " columns): " << full;
+        close();
+        return false;
+    }
+    std::vector<std::size_t> sizes(columns);
+    for (uint32 j = 0; j < columns; ++j) {
+        uint16 name_size;
+        if (end - p < 4) {
+            LOG(Error) << "Invalid BinaryRecorder header: " << full;
+            close();
+            return false;
+        }
+        RecordType type = static_cast<RecordType>(static_cast<uint8>(p[0]));
+        std::memcpy(&name_size, p + 2, sizeof(name_size));
+        p += 4;
+        if (record_type_size(type) == 0 || end - p < name_size) {
+            LOG(Error) << "Invalid BinaryRecorder header: " << full;
+            close();
+            return false;
+        }
+        schema_.push_back(RecordColumn(std::string(p, name_size), type));
+        sizes[j] = record_type_size(type);
+        p += name_size;
+    }
+    p = mapping_.data() + pad8(static_cast<std::size_t>(p - mapping_.data()));
+
+    // chunks
+    while (end - p >= static_cast<std::ptrdiff_t>(sizeof(uint64))) {
+        uint64 rows;
+        std::memcpy(&rows, p, sizeof(rows));
+        if (rows == 0 || rows > chunk_rows || static_cast<std::size_t>(end - p) < chunk_size(sizes, static_cast<std::size_t>(rows))) {
+            LOG(Warning) << "Ignoring incomplete chunk at end of " << full;
+            break;
+        }
+        chunks_.push_back(p);
+        chunk_rows_.push_back(static_cast<std::size_t>(rows));
+        row_count_ += static_cast<std::size_t>(rows);
+        p += chunk_size(sizes, static_cast<std::size_t>(rows));
+    }
+    return true;
+}
+
+void BinaryRecordingReader::close() {
+    mapping_.close();
+    schema_.clear();
+    chunks_.clear();
+    chunk_rows_.clear();
+    row_count_ = 0;
+    std::vector<char>().swap(gathered_);
+}
+
+bool BinaryRecordingReader::is_open() const {
+    return mapping_.is_open();
+}
+
+const std::vector<RecordColumn>& BinaryRecordingReader::schema() const {
+    return schema_;
+}
+
+std::size_t BinaryRecordingReader::column_count() const {
+    return schema_.size();
+}
+
+int BinaryRecordingReader::find_column(const std::string& name) const {
+    for (std::size_t j = 0; j < schema_.size(); ++j) {
+        if (schema_[j].name == name)
+            return static_cast<int>(j);
+    }
+    return -1;
+}
+
+std::size_t BinaryRecordingReader::row_count() const {
+    return row_count_;
+}
+
+std::size_t BinaryRecordingReader::chunk_count() const {
+    return chunks_.size();
+}
+
+std::size_t BinaryRecordingReader::chunk_rows(std::size_t chunk) const {
+    return chunk < chunk_rows_.size() ? chunk_rows_[chunk] : 0;
+}
+
+const char* BinaryRecordingReader::chunk_data(std::size_t chunk, std::size_t col) const {
+    const std::size_t rows = chunk_rows_[chunk];
+    std::size_t offset = sizeof(uint64);
+    for (std::size_t j = 0; j < col; ++j)
+        offset += pad8(rows * record_type_size(schema_[j].type));
+    return chunks_[chunk] + offset;
+}
+
+bool BinaryRecordingReader::check_column(std::size_t col) const {
+    if (col >= schema_.size()) {
+        LOG(Error) << "BinaryRecordingReader column " << col << " out of range";
+        return false;
+    }
+    return true;
+}
+
+//==============================================================================
+// CONVERSION
+//==============================================================================
+
+bool binary_recording_to_csv(const std::string& recording_path, const std::string& csv_path,
+                             Csv::FloatFormat format, std::size_t precision)
+{
+    BinaryRecordingReader reader(recording_path);
+    if (!reader.is_open())
+        return false;
+    File file(csv_path, WriteMode::Truncate);
+    if (!file.is_open())
+        return false;
+
+    const std::vector<RecordColumn>& schema = reader.schema();
+    const detail::CsvFormat csv_format(format, static_cast<int>(precision));
+    fmt::memory_buffer buf;
+    for (std::size_t j = 0; j < schema.size(); ++j) {
+        if (j > 0)
+            buf.push_back(',');
+        buf.append(schema[j].name.data(), schema[j].name.data() + schema[j].name.size());
+    }
+    buf.push_back('\n');
+
+    std::vector<const char*> data(schema.size());
+    for (std::size_t c = 0; c < reader.chunk_count(); ++c) {
+        for (std::size_t j = 0; j < schema.size(); ++j)
+            data[j] = reader.chunk_data(c, j);
+        for (std::size_t i = 0; i < reader.chunk_rows(c); ++i) {
+            for (std::size_t j = 0; j < schema.size(); ++j) {
+                if (j > 0)
+                    buf.push_back(',');
+                const char* value = data[j] + i * record_type_size(schema[j].type);
+                switch (schema[j].type) {
+                    case RecordInt8:    { signed char v; detail::record_load(value, RecordInt8, 1, &v); detail::csv_write_field(buf, static_cast<int>(v), csv_format); break; }
+                    case RecordInt16:   { int16 v;  detail::record_load(value, RecordInt16, 1, &v);  detail::csv_write_field(buf, v, csv_format); break; }
+                    case RecordInt32:   { int32 v;  detail::record_load(value, RecordInt32, 1, &v);  detail::csv_write_field(buf, v, csv_format); break; }
+                    case RecordInt64:   { int64 v;  detail::record_load(value, RecordInt64, 1, &v);  detail::csv_write_field(buf, v, csv_format); break; }
+                    case RecordUInt8:   { uint8 v;  detail::record_load(value, RecordUInt8, 1, &v);  detail::csv_write_field(buf, static_cast<unsigned int>(v), csv_format); break; }
+                    case RecordUInt16:  { uint16 v; detail::record_load(value, RecordUInt16, 1, &v); detail::csv_write_field(buf, v, csv_format); break; }
+                    case RecordUInt32:  { uint32 v; detail::record_load(value, RecordUInt32, 1, &v); detail::csv_write_field(buf, v, csv_format); break; }
+                    case RecordUInt64:  { uint64 v; detail::record_load(value, RecordUInt64, 1, &v); detail::csv_write_field(buf, v, csv_format); break; }
+                    case RecordFloat32: { float v;  detail::record_load(value, RecordFloat32, 1, &v); detail::csv_write_field(buf, v, csv_format); break; }
+                    case RecordFloat64: { double v; detail::record_load(value, RecordFloat64, 1, &v); detail::csv_write_field(buf, v, csv_format); break; }
+                }
+            }
+            buf.push_back('\n');
+            if (buf.size() >= 65536) {
+                file.write(buf.data(), buf.size());
+                buf.clear();
+            }
+        }
+    }
+    return file.write(buf.data(), buf.size()) == static_cast<int>(buf.size());
+}
+
+} // namespace util
+} // namespace mahi
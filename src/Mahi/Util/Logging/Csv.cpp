@@ -4,18 +4,61 @@
 namespace mahi {
 namespace util {    
 
-Csv::Csv() : File(), precision_(6) {}
+Csv::Csv() : File(), precision_(6), float_format_(General), buffer_size_(65536) {}
 
 Csv::Csv(const std::string &filepath, WriteMode w_mode, OpenMode o_mode) :
     File(filepath, w_mode, o_mode),
-    precision_(6)
+    precision_(6),
+    float_format_(General),
+    buffer_size_(65536)
 {
 
 }
 
+Csv::~Csv() {
+    flush();
+}
+
+bool Csv::open(const std::string &filepath, WriteMode mode, OpenMode o_mode) {
+    flush();
+    return File::open(filepath, mode, o_mode);
+}
+
 void Csv::set_precision(std::size_t precision) {
     precision_ = precision;
 }
 
+void Csv::set_float_format(FloatFormat format) {
+    float_format_ = format;
+}
+
+void Csv::set_buffer_size(std::size_t size) {
+    buffer_size_ = size;
+    if (buffer_.size() >= buffer_size_)
+        flush();
+}
+
+void Csv::flush() {
+    if (buffer_.size() > 0) {
+        File::write(buffer_.data(), buffer_.size());
+        buffer_.clear();
+    }
+}
+
+bool Csv::sync(bool data_only) {
+    flush();
+    return File::sync(data_only);
+}
+
+int Csv::write(const void* data, std::size_t count) {
+    flush();
+    return File::write(data, count);
+}
+
+void Csv::close() {
+    flush();
+    File::close();
+}
+
 } // util
 } // mahi
@@ -0,0 +1,330 @@
+#include <Mahi/Util/Logging/CsvReader.hpp>
+#include <Mahi/Util/Logging/File.hpp>
+#include <Mahi/Util/Logging/Log.hpp>
+#include <Mahi/Util/System.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+
+namespace mahi {
+namespace util {
+
+namespace detail {
+
+namespace {
+
+    /// Exactly representable powers of ten
+    const double POW10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                            1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                            1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    /// Parses with strtod, which needs a null terminated copy
+    bool parse_double_slow(const char* first, const char* last, double& value) {
+        char buffer[64];
+        std::string fallback;
+        const char* str;
+        std::size_t size = static_cast<std::size_t>(last - first);
+        if (size < sizeof(buffer)) {
+            std::memcpy(buffer, first, size);
+            buffer[size] = '\0';
+            str = buffer;
+        }
+        else {
+            fallback.assign(first, last);
+            str = fallback.c_str();
+        }
+        char* end;
+        value = std::strtod(str, &end);
+        return end != str;
+    }
+
+} // namespace
+
+bool csv_parse_double(const char* first, const char* last, double& value) {
+    const char* p = first;
+    bool negative = false;
+    if (p != last && (*p == '-' || *p == '+'))
+        negative = *p++ == '-';
+    // accumulate up to 19 significant digits
+    uint64 mantissa = 0;
+    int digits = 0;     // significant digits accumulated
+    int exponent = 0;   // decimal exponent of mantissa
+    bool any = false;   // any digits found
+    bool exact = true;  // all digits fit in mantissa
+    for (; p != last && static_cast<unsigned>(*p - '0') <= 9; ++p) {
+        any = true;
+        if (digits < 19) {
+            mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+            if (mantissa != 0)
+                ++digits;
+        }
+        else {
+            ++exponent;
+            exact = exact && *p == '0';
+        }
+    }
+    if (p != last && *p == '.') {
+        for (++p; p != last && static_cast<unsigned>(*p - '0') <= 9; ++p) {
+            any = true;
+            if (digits < 19) {
+                mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+                if (mantissa != 0)
+                    ++digits;
+                --exponent;
+            }
+            else {
+                exact = exact && *p == '0';
+            }
+        }
+    }
+    if (!any)  // "nan", "inf", garbage, etc.
+        return parse_double_slow(first, last, value);
+    if (p != last && (*p == 'e' || *p == 'E')) {
+        const char* e = p + 1;
+        bool exp_negative = false;
+        if (e != last && (*e == '-' || *e == '+'))
+            exp_negative = *e++ == '-';
+        if (e != last && static_cast<unsigned>(*e - '0') <= 9) {
+            int exp = 0;
+            for (; e != last && static_cast<unsigned>(*e - '0') <= 9; ++e) {
+                if (exp < 100000)
+                    exp = exp * 10 + (*e - '0');
+            }
+            exponent += exp_negative ? -exp : exp;
+        }
+    }
+    // Clinger's fast path: the mantissa and power of ten are both exact doubles,
+    // so a single multiplication or division is correctly rounded
+    if (exact && mantissa <= (uint64(1) << 53) && exponent >= -22 && exponent <= 22) {
+        double d = static_cast<double>(mantissa);
+        d = exponent < 0 ? d / POW10[-exponent] : d * POW10[exponent];
+        value = negative ? -d : d;
+        return true;
+    }
+    if (mantissa == 0 && exact) {
+        value = negative ? -0.0 : 0.0;
+        return true;
+    }
+    return parse_double_slow(first, last, value);
+}
+
+} // namespace detail
+
+CsvReader::CsvReader() :
+    begin_(nullptr),
+    end_(nullptr),
+    delimiter_(','),
+    index_stride_(0),
+    row_count_(0)
+{}
+
+CsvReader::CsvReader(const std::string& filepath, char delimiter) :
+    CsvReader()
+{
+    open(filepath, delimiter);
+}
+
+CsvReader::~CsvReader() {
+    close();
+}
+
+bool CsvReader::open(const std::string& filepath, char delimiter) {
+    close();
+    delimiter_ = delimiter;
+
+    std::string directory, filename, ext, full;
+    if (!parse_filepath(filepath, directory, filename, ext, full)) {
+        LOG(Error) << "Failed to parse filepath: " << filepath;
+        return false;
+    }
+
+    filepath_ = full;
+    if (!mapping_.open(full))
+        return false;
+    begin_ = mapping_.data();
+    end_   = begin_ + mapping_.size();
+    return true;
+}
+
+void CsvReader::close() {
+    mapping_.close();
+    begin_ = nullptr;
+    end_   = nullptr;
+    index_.clear();
+    index_stride_ = 0;
+    row_count_    = 0;
+}
+
+bool CsvReader::is_open() const {
+    return mapping_.is_open();
+}
+
+std::size_t CsvReader::row_count() const {
+    if (is_indexed())
+        return row_count_;
+    std::size_t rows = 0;
+    for (const char* p = begin_; p != end_; p = next_line(p))
+        rows++;
+    return rows;
+}
+
+const char* CsvReader::seek_row(std::size_t row) const {
+    const char* p = begin_;
+    std::size_t r = 0;
+    if (is_indexed()) {
+        if (row >= row_count_)
+            return end_;
+        std::size_t entry = row / index_stride_;
+        p = begin_ + index_[entry];
+        r = entry * index_stride_;
+    }
+    for (; r < row && p != end_; ++r)
+        p = next_line(p);
+    return p;
+}
+
+void CsvReader::build_index(std::size_t stride) {
+    index_.clear();
+    index_stride_ = stride > 0 ? stride : 1;
+    row_count_    = 0;
+    for (const char* p = begin_; p != end_; p = next_line(p)) {
+        if (row_count_ % index_stride_ == 0)
+            index_.push_back(static_cast<uint64>(p - begin_));
+        row_count_++;
+    }
+    if (index_.empty())
+        index_.push_back(0);  // empty file
+}
+
+namespace {
+    const char   CSV_INDEX_MAGIC[8] = {'M', 'A', 'H', 'I', 'C', 'S', 'V', 'I'};
+    const uint32 CSV_INDEX_VERSION  = 1;
+} // namespace
+
+// index file: "MAHICSVI" | uint32 version | uint64 file size | int64 file mtime |
+//             uint64 stride | uint64 rows | uint64 entries | uint64 offsets[entries]
+
+bool CsvReader::save_index(const std::string& index_path) const {
+    if (!is_open() || !is_indexed()) {
+        LOG(Error) << "CsvReader has no index to save";
+        return false;
+    }
+    std::string path = index_path.empty() ? filepath_ + ".idx" : index_path;
+    File file(path, WriteMode::Truncate);
+    if (!file.is_open())
+        return false;
+    const uint32 version = CSV_INDEX_VERSION;
+    const uint64 header[5] = {static_cast<uint64>(size()), static_cast<uint64>(mapping_.modified_time()),
+                              static_cast<uint64>(index_stride_), static_cast<uint64>(row_count_),
+                              static_cast<uint64>(index_.size())};
+    std::size_t bytes = index_.size() * sizeof(uint64);
+    if (file.write(CSV_INDEX_MAGIC, sizeof(CSV_INDEX_MAGIC)) < 0 ||
+        file.write(&version, sizeof(version)) < 0 ||
+        file.write(header, sizeof(header)) < 0 ||
+        file.write(index_.data(), bytes) != static_cast<int>(bytes))
+    {
+        LOG(Error) << "Failed to write CSV index: " << path;
+        return false;
+    }
+    return true;
+}
+
+bool CsvReader::load_index(const std::string& index_path) {
+    if (!is_open())
+        return false;
+    std::string path = index_path.empty() ? filepath_ + ".idx" : index_path;
+    std::ifstream in(path.c_str(), std::ios::binary);
+    if (!in.is_open())
+        return false;
+    char magic[8];
+    uint32 version;
+    uint64 header[5];
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    in.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!in || std::memcmp(magic, CSV_INDEX_MAGIC, sizeof(magic)) != 0 || version != CSV_INDEX_VERSION) {
+        LOG(Error) << "Invalid CSV index: " << path;
+        return false;
+    }
+    if (header[0] != static_cast<uint64>(size()) || header[1] != static_cast<uint64>(mapping_.modified_time())) {
+        LOG(Warning) << "CSV index " << path << " is out of date with " << filepath_;
+        return false;
+    }
+    const uint64 stride = header[2], rows = header[3], entries = header[4];
+    if (stride == 0 || entries != (rows == 0 ? 1 : (rows + stride - 1) / stride)) {
+        LOG(Error) << "Invalid CSV index: " << path;
+        return false;
+    }
+    std::vector<uint64> index(static_cast<std::size_t>(entries));
+    in.read(reinterpret_cast<char*>(index.data()), static_cast<std::streamsize>(entries * sizeof(uint64)));
+    if (!in) {
+        LOG(Error) << "Invalid CSV index: " << path;
+        return false;
+    }
+    for (std::size_t i = 0; i < index.size(); ++i) {
+        if (index[i] > static_cast<uint64>(size())) {
+            LOG(Error) << "Invalid CSV index: " << path;
+            return false;
+        }
+    }
+    index_.swap(index);
+    index_stride_ = static_cast<std::size_t>(stride);
+    row_count_    = static_cast<std::size_t>(rows);
+    return true;
+}
+
+CsvReader::Cursor::Cursor(const CsvReader& reader, std::size_t row, std::size_t col_offset) :
+    reader_(&reader),
+    p_(reader.seek_row(row)),
+    row_(row),
+    col_offset_(col_offset)
+{}
+
+void CsvReader::Cursor::seek(std::size_t row) {
+    p_   = reader_->seek_row(row);
+    row_ = row;
+}
+
+std::vector<const char*> CsvReader::split_lines(const char* p, std::size_t parts) const {
+    // ranges smaller than this aren't worth a thread
+    const std::size_t min_range = 256 * 1024;
+    const std::size_t size = static_cast<std::size_t>(end_ - p);
+    parts = (std::max)(static_cast<std::size_t>(1), (std::min)(parts, size / min_range));
+    std::vector<const char*> bounds(1, p);
+    for (std::size_t k = 1; k < parts; ++k) {
+        const char* q = p + size / parts * k;
+        if (q[-1] != '\n')
+            q = next_line(q);
+        if (q != bounds.back() && q != end_)
+            bounds.push_back(q);
+    }
+    bounds.push_back(end_);
+    return bounds;
+}
+
+std::size_t CsvReader::count_lines(const char* first, const char* last) const {
+    std::size_t lines = 0;
+    const char* p = first;
+    while (const char* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(last - p)))) {
+        lines++;
+        p = nl + 1;
+    }
+    return p != last ? lines + 1 : lines;  // final line without '\n'
+}
+
+bool CsvReader::find_field(const char* p, const char* eol, std::size_t col, const char*& first, const char*& last) const {
+    for (std::size_t c = 0; c < col; ++c) {
+        const char* delim = static_cast<const char*>(std::memchr(p, delimiter_, static_cast<std::size_t>(eol - p)));
+        if (!delim)
+            return false;
+        p = delim + 1;
+    }
+    const char* delim = static_cast<const char*>(std::memchr(p, delimiter_, static_cast<std::size_t>(eol - p)));
+    first = p;
+    last  = delim ? delim : eol;
+    return true;
+}
+
+} // namespace util
+} // namespace mahi
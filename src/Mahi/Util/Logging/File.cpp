@@ -80,6 +80,20 @@ int File::write(const void* data, std::size_t size) {
 #endif
 }
 
+bool File::sync(bool data_only) {
+    if (file_handle_ == -1)
+        return false;
+#ifdef _WIN32
+    (void)data_only;
+    return ::_commit(file_handle_) == 0;
+#elif defined(__APPLE__)
+    (void)data_only;
+    return ::fsync(file_handle_) == 0;
+#else
+    return (data_only ? ::fdatasync(file_handle_) : ::fsync(file_handle_)) == 0;
+#endif
+}
+
 off_t File::seek(off_t offset, int whence) {
 #ifdef _WIN32
     return file_handle_ != -1 ? ::_lseek(file_handle_, offset, whence) : -1;
@@ -100,7 +114,7 @@ off_t File::seek_end(off_t offset) {
     return seek(offset, SEEK_END);
 }
 
-bool File::is_open() {
+bool File::is_open() const {
     return file_handle_ != -1;
 }
 
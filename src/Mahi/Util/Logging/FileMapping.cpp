@@ -0,0 +1,136 @@
+#include <Mahi/Util/Logging/Detail/FileMapping.hpp>
+#include <Mahi/Util/Logging/Log.hpp>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+namespace mahi {
+namespace util {
+namespace detail {
+
+#ifdef _WIN32
+FileMapping::FileMapping() :
+    file_handle_(INVALID_HANDLE_VALUE),
+    mapping_handle_(nullptr),
+#else
+FileMapping::FileMapping() :
+    file_handle_(-1),
+#endif
+    data_(nullptr),
+    size_(0)
+{}
+
+FileMapping::~FileMapping() {
+    close();
+}
+
+bool FileMapping::open(const std::string& filepath) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        LOG(Error) << "Failed to open file: " << filepath;
+        return false;
+    }
+    file_handle_ = file;
+    LARGE_INTEGER length;
+    GetFileSizeEx(file, &length);
+    if (length.QuadPart == 0)
+        return true;
+    mapping_handle_ = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    void* view = mapping_handle_ ? MapViewOfFile(mapping_handle_, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        LOG(Error) << "Failed to map file: " << filepath;
+        close();
+        return false;
+    }
+    data_ = static_cast<const char*>(view);
+    size_ = static_cast<std::size_t>(length.QuadPart);
+#else
+    file_handle_ = ::open(filepath.c_str(), O_RDONLY);
+    if (file_handle_ == -1) {
+        LOG(Error) << "Failed to open file: " << filepath;
+        return false;
+    }
+    struct stat info;
+    if (::fstat(file_handle_, &info) != 0) {
+        LOG(Error) << "Failed to stat file: " << filepath;
+        close();
+        return false;
+    }
+    if (info.st_size == 0)
+        return true;
+    void* view = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file_handle_, 0);
+    if (view == MAP_FAILED) {
+        LOG(Error) << "Failed to map file: " << filepath;
+        close();
+        return false;
+    }
+    ::madvise(view, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(view);
+    size_ = static_cast<std::size_t>(info.st_size);
+#endif
+    return true;
+}
+
+void FileMapping::close() {
+#ifdef _WIN32
+    if (data_)
+        UnmapViewOfFile(data_);
+    if (mapping_handle_)
+        CloseHandle(mapping_handle_);
+    if (file_handle_ != INVALID_HANDLE_VALUE)
+        CloseHandle(file_handle_);
+    mapping_handle_ = nullptr;
+    file_handle_    = INVALID_HANDLE_VALUE;
+#else
+    if (data_)
+        ::munmap(const_cast<char*>(data_), size_);
+    if (file_handle_ != -1)
+        ::close(file_handle_);
+    file_handle_ = -1;
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
+
+bool FileMapping::is_open() const {
+#ifdef _WIN32
+    return file_handle_ != INVALID_HANDLE_VALUE;
+#else
+    return file_handle_ != -1;
+#endif
+}
+
+int64 FileMapping::modified_time() const {
+#ifdef _WIN32
+    FILETIME ft;
+    if (!GetFileTime(file_handle_, NULL, NULL, &ft))
+        return 0;
+    ULARGE_INTEGER t;
+    t.LowPart  = ft.dwLowDateTime;
+    t.HighPart = ft.dwHighDateTime;
+    return static_cast<int64>(t.QuadPart);
+#else
+    struct stat info;
+    if (::fstat(file_handle_, &info) != 0)
+        return 0;
+#ifdef __APPLE__
+    return static_cast<int64>(info.st_mtimespec.tv_sec) * 1000000000 + info.st_mtimespec.tv_nsec;
+#else
+    return static_cast<int64>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+#endif
+#endif
+}
+
+} // namespace detail
+} // namespace util
+} // namespace mahi
@@ -5,7 +5,11 @@ namespace util {
 
 #ifdef MAHI_DEFAULT_LOG
     static ColorConsoleWriter<TxtFormatter> default_console_writer(Info);
+#ifdef MAHI_ASYNC_LOG
+    Logger<DEFAULT_LOGGER>* MahiLogger = &init_logger<DEFAULT_LOGGER>(Verbose, "MAHI.log", 256000, 10).add_writer(&default_console_writer).enable_async();
+#else
     Logger<DEFAULT_LOGGER>* MahiLogger = &init_logger<DEFAULT_LOGGER>(Verbose, "MAHI.log", 256000, 10).add_writer(&default_console_writer);
+#endif
 #else
     Logger<DEFAULT_LOGGER>* MahiLogger = nullptr;
 #endif
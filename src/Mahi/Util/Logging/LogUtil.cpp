@@ -1,9 +1,76 @@
 #include <Mahi/Util/Logging/Detail/LogUtil.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <cstdio>
 #include <cstring>
+#include <new>
+#include <vector>
 
 namespace mahi {
 namespace util {
 
+namespace {
+
+    /// Per-thread overflow buffer for messages larger than MAHI_LOG_RECORD_SIZE.
+    /// It only grows, so after warming up no further allocations are made.
+    struct LogArena {
+        LogArena() : in_use(false) {}
+        std::vector<char> buffer;
+        bool in_use;
+    };
+
+    LogArena& get_arena() {
+        static thread_local LogArena arena;
+        return arena;
+    }
+
+    /// Copies the function name out of a signature (e.g. "void ns::Foo::bar(int)" -> "ns::Foo::bar")
+    void process_function_name(const char* func, char* out, std::size_t out_size) {
+        const char* func_begin = func;
+        const char* func_end   = nullptr;
+#if !((defined(_WIN32) && !defined(__MINGW32__)) || defined(__OBJC__))
+        func_end = ::strchr(func_begin, '(');
+        if (func_end) {
+            for (const char* i = func_end - 1; i >= func_begin;
+                --i)  // search backwards for the first space char
+            {
+                if (*i == ' ') {
+                    func_begin = i + 1;
+                    break;
+                }
+            }
+        }
+#endif
+        if (!func_end)
+            func_end = func_begin + std::strlen(func_begin);
+        std::size_t size = static_cast<std::size_t>(func_end - func_begin);
+        if (size >= out_size)
+            size = out_size - 1;
+        std::memcpy(out, func_begin, size);
+        out[size] = '\0';
+    }
+
+} // namespace
+
+    namespace detail {
+
+    LogStream::LogStream(LogRecord& record) : os(this), record_(record) {}
+
+    LogStream::int_type LogStream::overflow(int_type c) {
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            char ch = traits_type::to_char_type(c);
+            record_.append(&ch, 1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize LogStream::xsputn(const char* s, std::streamsize n) {
+        record_.append(s, static_cast<std::size_t>(n));
+        return n;
+    }
+
+    } // namespace detail
+
     LogRecord::LogRecord(Severity severity,
         const char* func,
         size_t line,
@@ -14,27 +81,184 @@ namespace util {
         tid_(mahi::util::get_thread_id()),
         line_(line),
         func_(func),
-        file_(file)
+        file_(file),
+        message_(inline_),
+        size_(0),
+        capacity_(MAHI_LOG_RECORD_SIZE),
+        arena_(false),
+        stream_(nullptr)
     {
+        inline_[0] = '\0';
+        func_str_[0] = '\0';
+    }
+
+    LogRecord::LogRecord(Severity severity,
+        const char* func,
+        size_t line,
+        const char* file,
+        Timestamp timestamp,
+        unsigned int tid)
+        : timestamp_(timestamp),
+        severity_(severity),
+        tid_(tid),
+        line_(line),
+        func_(func),
+        file_(file),
+        message_(inline_),
+        size_(0),
+        capacity_(MAHI_LOG_RECORD_SIZE),
+        arena_(false),
+        stream_(nullptr)
+    {
+        inline_[0] = '\0';
+        func_str_[0] = '\0';
+    }
+
+    LogRecord::~LogRecord() {
+        if (stream_)
+            stream_->~LogStream();
+        if (arena_)
+            get_arena().in_use = false;
+    }
+
+    bool LogRecord::reserve(std::size_t size) {
+        std::size_t required = size_ + size + 1;
+        if (required <= capacity_)
+            return true;
+        LogArena& arena = get_arena();
+        if (!arena_ && arena.in_use)
+            return false;  // another Record on this thread holds the arena
+        if (arena.buffer.size() < required)
+            arena.buffer.resize((std::max)(required, 2 * arena.buffer.size()));
+        if (!arena_) {
+            std::memcpy(arena.buffer.data(), message_, size_ + 1);
+            arena.in_use = true;
+            arena_       = true;
+        }
+        message_  = arena.buffer.data();
+        capacity_ = arena.buffer.size();
+        return true;
+    }
+
+    LogRecord& LogRecord::append(const char* data, std::size_t size) {
+        if (!reserve(size))
+            size = capacity_ - size_ - 1;  // truncate
+        std::memcpy(message_ + size_, data, size);
+        size_ += size;
+        message_[size_] = '\0';
+        return *this;
+    }
+
+    std::ostream& LogRecord::stream() {
+        if (!stream_)
+            stream_ = new (&stream_storage_) detail::LogStream(*this);
+        return stream_->os;
     }
 
-    LogRecord::~LogRecord() { }
+    template <typename T>
+    LogRecord& LogRecord::append_printf(const char* fmt, T value) {
+        // matches the output of std::ostream with default flags and precision
+        char buffer[64];
+        int size = std::snprintf(buffer, sizeof(buffer), fmt, value);
+        if (size > 0)
+            append(buffer, (std::min)(static_cast<std::size_t>(size), sizeof(buffer) - 1));
+        return *this;
+    }
 
     LogRecord& LogRecord::operator <<(char data) {
-        char str[] = { data, 0 };
-        return *this << str;
+        if (stream_) {
+            stream_->os << data;
+            return *this;
+        }
+        return append(&data, 1);
+    }
+
+    LogRecord& LogRecord::operator <<(bool data) {
+        if (stream_) {
+            stream_->os << data;
+            return *this;
+        }
+        return append(data ? "1" : "0", 1);
+    }
+
+#define MAHI_LOG_INTEGER_OPERATOR(type)                  \
+    LogRecord& LogRecord::operator <<(type data) {       \
+        if (stream_) {                                   \
+            stream_->os << data;                         \
+            return *this;                                \
+        }                                                \
+        fmt::format_int formatted(data);                 \
+        return append(formatted.data(), formatted.size()); \
+    }
+
+    MAHI_LOG_INTEGER_OPERATOR(short)
+    MAHI_LOG_INTEGER_OPERATOR(unsigned short)
+    MAHI_LOG_INTEGER_OPERATOR(int)
+    MAHI_LOG_INTEGER_OPERATOR(unsigned int)
+    MAHI_LOG_INTEGER_OPERATOR(long)
+    MAHI_LOG_INTEGER_OPERATOR(unsigned long)
+    MAHI_LOG_INTEGER_OPERATOR(long long)
+    MAHI_LOG_INTEGER_OPERATOR(unsigned long long)
+
+#undef MAHI_LOG_INTEGER_OPERATOR
+
+    LogRecord& LogRecord::operator <<(float data) {
+        if (stream_) {
+            stream_->os << data;
+            return *this;
+        }
+        return append_printf("%g", static_cast<double>(data));
+    }
+
+    LogRecord& LogRecord::operator <<(double data) {
+        if (stream_) {
+            stream_->os << data;
+            return *this;
+        }
+        return append_printf("%g", data);
+    }
+
+    LogRecord& LogRecord::operator <<(long double data) {
+        if (stream_) {
+            stream_->os << data;
+            return *this;
+        }
+        return append_printf("%Lg", data);
+    }
+
+    LogRecord& LogRecord::operator <<(const char* data) {
+        if (stream_) {
+            stream_->os << data;
+            return *this;
+        }
+        if (!data) {
+            stream() << data;  // let std::ostream report the error as it always has
+            return *this;
+        }
+        return append(data, std::strlen(data));
+    }
+
+    LogRecord& LogRecord::operator <<(char* data) {
+        return *this << static_cast<const char*>(data);
+    }
+
+    LogRecord& LogRecord::operator <<(const std::string& data) {
+        if (stream_) {
+            stream_->os << data;
+            return *this;
+        }
+        return append(data.data(), data.size());
     }
 
     LogRecord& LogRecord::operator <<(std::ostream& (*data)(std::ostream&))
     {
-        message_ << data;
+        stream() << data;
         return *this;
     }
 
-    const char* LogRecord::get_message() const {
-        message_str_ = message_.str();
-        return message_str_.c_str();
-    }
+    const char* LogRecord::get_message() const { return message_; }
+
+    std::size_t LogRecord::get_message_size() const { return size_; }
 
     const mahi::util::Timestamp& LogRecord::get_timestamp() const { return timestamp_; };
 
@@ -45,34 +269,14 @@ namespace util {
     size_t LogRecord::get_line() const { return line_; }
 
     const char* LogRecord::get_func() const {
-        func_str_ = process_function_name(func_);
-        return func_str_.c_str();
+        if (func_str_[0] == '\0')
+            process_function_name(func_, func_str_, sizeof(func_str_));
+        return func_str_;
     }
 
-    const char* LogRecord::get_file() const { return file_; }
-
-    inline std::string process_function_name(const char* func) {
-#if (defined(_WIN32) && !defined(__MINGW32__)) || defined(__OBJC__)
-        return std::string(func);
-#else
-        const char* funcBegin = func;
-        const char* funcEnd = ::strchr(funcBegin, '(');
-
-        if (!funcEnd) {
-            return std::string(func);
-        }
-        for (const char* i = funcEnd - 1; i >= funcBegin;
-            --i)  // search backwards for the first space char
-        {
-            if (*i == ' ') {
-                funcBegin = i + 1;
-                break;
-            }
-        }
-        return std::string(funcBegin, funcEnd);
-#endif
-    }
+    const char* LogRecord::get_func_signature() const { return func_; }
 
+    const char* LogRecord::get_file() const { return file_; }
 
 } // namespace util
 } // namespace mahi
@@ -0,0 +1,257 @@
+#include <Mahi/Util/Logging/MappedFile.hpp>
+#include <Mahi/Util/Logging/Log.hpp>
+#include <Mahi/Util/System.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+namespace mahi {
+namespace util {
+
+namespace {
+
+    /// Granularity of mapping offsets
+    uint64 map_granularity() {
+#ifdef _WIN32
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return info.dwAllocationGranularity;
+#else
+        return static_cast<uint64>(::sysconf(_SC_PAGESIZE));
+#endif
+    }
+
+    inline uint64 round_up(uint64 value, uint64 multiple) {
+        return (value + multiple - 1) / multiple * multiple;
+    }
+
+} // namespace
+
+#ifdef _WIN32
+MappedFile::MappedFile() :
+    file_handle_(INVALID_HANDLE_VALUE),
+    mapping_handle_(nullptr),
+#else
+MappedFile::MappedFile() :
+    file_handle_(-1),
+#endif
+    chunk_(nullptr),
+    chunk_offset_(0),
+    chunk_size_(0),
+    min_chunk_(0),
+    size_(0),
+    capacity_(0)
+{}
+
+MappedFile::MappedFile(const std::string& filepath, WriteMode w_mode, OpenMode o_mode, std::size_t chunk_size) :
+    MappedFile()
+{
+    open(filepath, w_mode, o_mode, chunk_size);
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& filepath, WriteMode w_mode, OpenMode o_mode, std::size_t chunk_size) {
+    close();
+
+    // parse filepath
+    std::string directory, filename, ext, full;
+    if (!parse_filepath(filepath, directory, filename, ext, full)) {
+        LOG(Error) << "Failed to parse filepath: " << filepath;
+        return false;
+    }
+
+    // make directory if it doesn't exist
+    if (o_mode == OpenMode::OpenOrCreate && !directory_exits(directory)) {
+        if (!create_directory(directory)) {
+            return false;
+        }
+        LOG(Verbose) << "Created directory " << directory << " for file: " << full;
+    }
+
+    // open file
+#ifdef _WIN32
+    DWORD disposition;
+    if (o_mode == OpenMode::OpenOrCreate)
+        disposition = w_mode == WriteMode::Truncate ? CREATE_ALWAYS : OPEN_ALWAYS;
+    else
+        disposition = w_mode == WriteMode::Truncate ? TRUNCATE_EXISTING : OPEN_EXISTING;
+    HANDLE file = CreateFileA(full.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL,
+                              disposition, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        LOG(Error) << "Failed to open file: " << full;
+        return false;
+    }
+    LARGE_INTEGER length;
+    GetFileSizeEx(file, &length);
+    file_handle_ = file;
+    size_        = static_cast<uint64>(length.QuadPart);
+#else
+    int open_flags = o_mode == OpenMode::OpenOrCreate ? O_CREAT | O_RDWR : O_RDWR;
+    if (w_mode == WriteMode::Truncate)
+        open_flags |= O_TRUNC;
+    file_handle_ = ::open(full.c_str(), open_flags, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (file_handle_ == -1) {
+        LOG(Error) << "Failed to open file: " << full;
+        return false;
+    }
+    struct stat info;
+    size_ = ::fstat(file_handle_, &info) == 0 ? static_cast<uint64>(info.st_size) : 0;
+#endif
+
+    filepath_  = full;
+    capacity_  = size_;
+    min_chunk_ = static_cast<std::size_t>(round_up((std::max)(chunk_size, static_cast<std::size_t>(1)), map_granularity()));
+    return true;
+}
+
+char* MappedFile::reserve(std::size_t size) {
+    if (!is_open())
+        return nullptr;
+    if (!chunk_ || size_ + size > chunk_offset_ + chunk_size_) {
+        if (!map_chunk(size_ + size))
+            return nullptr;
+    }
+    char* ptr = chunk_ + (size_ - chunk_offset_);
+    size_ += size;
+    return ptr;
+}
+
+int MappedFile::write(const void* data, std::size_t size) {
+    char* ptr = reserve(size);
+    if (!ptr)
+        return -1;
+    std::memcpy(ptr, data, size);
+    return static_cast<int>(size);
+}
+
+uint64 MappedFile::size() const {
+    return size_;
+}
+
+bool MappedFile::map_chunk(uint64 end) {
+    unmap_chunk();
+    const uint64 offset = size_ / map_granularity() * map_granularity();
+    const uint64 length = round_up((std::max)(static_cast<uint64>(min_chunk_), end - offset), map_granularity());
+#ifdef _WIN32
+    // the mapping object extends the file to its maximum size
+    const uint64 capacity = (std::max)(capacity_, offset + length);
+    mapping_handle_ = CreateFileMappingA(file_handle_, NULL, PAGE_READWRITE,
+                                         static_cast<DWORD>(capacity >> 32),
+                                         static_cast<DWORD>(capacity & 0xFFFFFFFF), NULL);
+    if (!mapping_handle_) {
+        LOG(Error) << "Failed to map file: " << filepath_;
+        return false;
+    }
+    capacity_ = capacity;
+    chunk_ = static_cast<char*>(MapViewOfFile(mapping_handle_, FILE_MAP_WRITE,
+                                              static_cast<DWORD>(offset >> 32),
+                                              static_cast<DWORD>(offset & 0xFFFFFFFF),
+                                              static_cast<SIZE_T>(length)));
+    if (!chunk_) {
+        CloseHandle(mapping_handle_);
+        mapping_handle_ = nullptr;
+        LOG(Error) << "Failed to map file: " << filepath_;
+        return false;
+    }
+#else
+    if (offset + length > capacity_) {
+        // preallocate so that page faults on the mapping can't hit ENOSPC (SIGBUS)
+        int result = ENOSYS;
+#ifndef __APPLE__
+        result = ::posix_fallocate(file_handle_, static_cast<off_t>(capacity_),
+                                   static_cast<off_t>(offset + length - capacity_));
+#endif
+        if (result != 0 && ::ftruncate(file_handle_, static_cast<off_t>(offset + length)) != 0) {
+            LOG(Error) << "Failed to allocate " << (offset + length) << " bytes for file: " << filepath_;
+            return false;
+        }
+        capacity_ = offset + length;
+    }
+    void* chunk = ::mmap(nullptr, static_cast<std::size_t>(length), PROT_READ | PROT_WRITE,
+                         MAP_SHARED, file_handle_, static_cast<off_t>(offset));
+    if (chunk == MAP_FAILED) {
+        LOG(Error) << "Failed to map file: " << filepath_;
+        return false;
+    }
+    chunk_ = static_cast<char*>(chunk);
+#endif
+    chunk_offset_ = offset;
+    chunk_size_   = static_cast<std::size_t>(length);
+    return true;
+}
+
+void MappedFile::unmap_chunk() {
+    if (!chunk_)
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile(chunk_);
+    CloseHandle(mapping_handle_);
+    mapping_handle_ = nullptr;
+#else
+    ::munmap(chunk_, chunk_size_);
+#endif
+    chunk_      = nullptr;
+    chunk_size_ = 0;
+}
+
+bool MappedFile::sync() {
+    if (!is_open())
+        return false;
+#ifdef _WIN32
+    if (chunk_ && !FlushViewOfFile(chunk_, 0))
+        return false;
+    return FlushFileBuffers(file_handle_) != 0;
+#else
+    if (chunk_ && ::msync(chunk_, chunk_size_, MS_SYNC) != 0)
+        return false;
+    return ::fsync(file_handle_) == 0;
+#endif
+}
+
+bool MappedFile::is_open() const {
+#ifdef _WIN32
+    return file_handle_ != INVALID_HANDLE_VALUE;
+#else
+    return file_handle_ != -1;
+#endif
+}
+
+void MappedFile::close() {
+    if (!is_open())
+        return;
+    unmap_chunk();
+#ifdef _WIN32
+    LARGE_INTEGER length;
+    length.QuadPart = static_cast<LONGLONG>(size_);
+    if (!SetFilePointerEx(file_handle_, length, NULL, FILE_BEGIN) || !SetEndOfFile(file_handle_)) {
+        LOG(Error) << "Failed to truncate file: " << filepath_;
+    }
+    CloseHandle(file_handle_);
+    file_handle_ = INVALID_HANDLE_VALUE;
+#else
+    if (::ftruncate(file_handle_, static_cast<off_t>(size_)) != 0) {
+        LOG(Error) << "Failed to truncate file: " << filepath_;
+    }
+    ::close(file_handle_);
+    file_handle_ = -1;
+#endif
+    chunk_offset_ = 0;
+    size_         = 0;
+    capacity_     = 0;
+}
+
+}  // namespace util
+}  // namespace mahi
@@ -1,5 +1,6 @@
 #include <Mahi/Util/Math/Butterworth.hpp>
 #include <Mahi/Util/Math/Constants.hpp>
+#include <algorithm>
 #include <complex>
 
 namespace mahi {
@@ -82,6 +83,36 @@ std::vector<double> compute_b(std::size_t n,
     return b;
 }
 
+/// computes the second-order sections of the digital Butterworth filter
+std::vector<Sos> compute_sos(std::size_t n, double Wn, Butterworth::Type type) {
+    double V = std::tan(Wn * PI / 2.0);
+    std::vector<std::complex<double>> ap = butt_poles(n);  // analog poles
+    // zeros are all at z = -1 (lowpass) or z = 1 (highpass)
+    const double zero = type == Butterworth::Highpass ? 1.0 : -1.0;
+    std::vector<Sos> sos;
+    for (std::size_t i = 0; i < ap.size(); ++i) {
+        std::complex<double> dp = (1.0 + V * ap[i]) / (1.0 - V * ap[i]);  // bilinear transform
+        Sos s;
+        if (ap[i].imag() != 0.0) {
+            // conjugate pair (p, conj(p)); skip the conjugate
+            s = {{1.0, -2.0 * zero, 1.0, 1.0, -2.0 * dp.real(), std::norm(dp)}};
+            ++i;
+        }
+        else {
+            s = {{1.0, -zero, 0.0, 1.0, -dp.real(), 0.0}};
+        }
+        // unity gain at z = 1 (lowpass) or z = -1 (highpass)
+        double z = -zero;
+        double gain = (s[3] + s[4] * z + s[5]) / (s[0] + s[1] * z + s[2]);
+        for (std::size_t j = 0; j < 3; ++j)
+            s[j] *= gain;
+        sos.push_back(s);
+    }
+    // poles nearest the unit circle (largest a2, i.e. |p|^2) last
+    std::stable_sort(sos.begin(), sos.end(), [](const Sos& l, const Sos& r) { return l[5] < r[5]; });
+    return sos;
+}
+
 Butterworth::Butterworth() : Filter({ 1,0 }, { 1,0 }) {
 
 }
@@ -111,5 +142,13 @@ void Butterworth::configure(std::size_t n, Frequency cutoff, Frequency sample, T
     configure(n, 2.0 * static_cast<double>(cutoff.as_hertz()) / static_cast<double>(sample.as_hertz()), type, seeding);
 }
 
+std::vector<Sos> Butterworth::design_sos(std::size_t n, double Wn, Type type) {
+    return compute_sos(n, Wn, type);
+}
+
+std::vector<Sos> Butterworth::design_sos(std::size_t n, Frequency cutoff, Frequency sample, Type type) {
+    return design_sos(n, 2.0 * static_cast<double>(cutoff.as_hertz()) / static_cast<double>(sample.as_hertz()), type);
+}
+
 }  // namespace util
 }  // namespace mahi
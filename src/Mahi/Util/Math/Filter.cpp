@@ -1,5 +1,7 @@
 #include <Mahi/Util/Logging/Log.hpp>
 #include <Mahi/Util/Math/Filter.hpp>
+#include <Mahi/Util/Math/Detail/FilterKernels.hpp>
+#include <algorithm>
 #include <iostream>
 
 namespace mahi {
@@ -33,6 +35,29 @@ double Filter::update(const double x) {
     return value_;
 }
 
+void Filter::process(const double* in, double* out, std::size_t n) {
+    if (n == 0)
+        return;
+    if (first_update_) {
+        if (has_seeding_) {
+            seed(in[0], seed_count_);
+        }
+        first_update_ = false;
+    }
+    if (!will_filter_) {
+        if (out != in)
+            std::copy(in, in + n, out);
+    }
+    else if (n_ <= detail::FILTER_BLOCK_MAX_ORDER) {
+        detail::iir_block(b_.data(), a_.data(), n_, s_.data(), in, out, n);
+    }
+    else {
+        for (std::size_t i = 0; i < n; ++i)
+            out[i] = dir_form_ii_t(in[i]);
+    }
+    value_ = out[n - 1];
+}
+
 double Filter::get_value() const {
     return value_;
 }
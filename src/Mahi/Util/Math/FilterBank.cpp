@@ -0,0 +1,102 @@
+#include <Mahi/Util/Logging/Log.hpp>
+#include <Mahi/Util/Math/FilterBank.hpp>
+#include <Mahi/Util/Math/Detail/FilterKernels.hpp>
+#include <algorithm>
+
+namespace mahi {
+namespace util {
+
+FilterBank::FilterBank(const std::vector<double>& b, const std::vector<double>& a, std::size_t channels, unsigned int seeding) :
+    channels_(channels),
+    stride_((channels + 7) & ~std::size_t(7)),
+    n_(0),
+    y_(channels, 0.0),
+    has_seeding_(seeding > 0),
+    first_update_(true),
+    will_filter_(false),
+    seed_count_(seeding)
+{
+    set_coefficients(b, a);
+}
+
+FilterBank::FilterBank(const Filter& filter, std::size_t channels, unsigned int seeding) :
+    FilterBank(filter.get_b(), filter.get_a(), channels, seeding)
+{}
+
+void FilterBank::update(const double* x, double* y) {
+    if (n_ == 0 || channels_ == 0)
+        return;
+    if (!will_filter_) {
+        std::copy(x, x + channels_, y_.begin());
+    }
+    else {
+        if (first_update_ && has_seeding_) {
+            for (unsigned int i = 0; i < seed_count_; ++i)
+                detail::bank_update(b_.data(), a_.data(), n_, s_.data(), stride_, x, y_.data(), channels_);
+        }
+        detail::bank_update(b_.data(), a_.data(), n_, s_.data(), stride_, x, y_.data(), channels_);
+    }
+    first_update_ = false;
+    if (y != y_.data())
+        std::copy(y_.begin(), y_.end(), y);
+}
+
+const std::vector<double>& FilterBank::update(const std::vector<double>& x) {
+    if (x.size() != channels_) {
+        LOG(Error) << "FilterBank input size " << x.size() << " does not match channel count " << channels_;
+        return y_;
+    }
+    update(x.data(), y_.data());
+    return y_;
+}
+
+double FilterBank::get_value(std::size_t channel) const {
+    return y_[channel];
+}
+
+const std::vector<double>& FilterBank::get_values() const {
+    return y_;
+}
+
+std::size_t FilterBank::get_channels() const {
+    return channels_;
+}
+
+void FilterBank::reset() {
+    std::fill(s_.begin(), s_.end(), 0.0);
+    first_update_ = true;
+}
+
+const std::vector<double>& FilterBank::get_b() const {
+    return b_;
+}
+
+const std::vector<double>& FilterBank::get_a() const {
+    return a_;
+}
+
+void FilterBank::set_seeding(unsigned int seeding) {
+    has_seeding_ = (seeding > 0);
+    seed_count_ = seeding;
+}
+
+void FilterBank::set_coefficients(const std::vector<double>& b,
+                                  const std::vector<double>& a) {
+    if (a.size() != b.size()) {
+        LOG(Error) << "FilterBank coefficient vector sizes do not match";
+    }
+    else if (a.size() < 2) {
+        LOG(Error) << "Coefficient vectors must be longer than length 1";
+    }
+    else {
+        b_ = b;
+        a_ = a;
+        n_ = a_.size() - 1;
+        s_.assign(n_ * stride_, 0.0);
+        reset();
+        will_filter_ = !(a_ == std::vector<double>({1,0}) && b_ == std::vector<double>({1,0}));
+    }
+}
+
+} // namespace util
+} // namespace mahi
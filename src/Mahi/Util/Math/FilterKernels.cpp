@@ -0,0 +1,238 @@
+#include <Mahi/Util/Math/Detail/FilterKernels.hpp>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define MAHI_FILTER_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(MAHI_FILTER_X86) && (defined(__GNUC__) || defined(__clang__))
+#define MAHI_TARGET_AVX __attribute__((target("avx")))
+#else
+#define MAHI_TARGET_AVX
+#endif
+
+namespace mahi {
+namespace util {
+namespace detail {
+
+namespace {
+
+    void fir_block_scalar(const double* b, std::size_t n, const double* x, double* w, std::size_t count) {
+        for (std::size_t k = 0; k < count; ++k) {
+            double acc = b[0] * x[k];
+            for (std::size_t i = 1; i <= n; ++i)
+                acc += b[i] * x[k - i];
+            w[k] = acc;
+        }
+    }
+
+    void bank_update_scalar(const double* b, const double* a, std::size_t n, double* s, std::size_t stride,
+                            const double* x, double* y, std::size_t first, std::size_t channels) {
+        for (std::size_t c = first; c < channels; ++c) {
+            const double xc = x[c];
+            const double yc = (s[c] + b[0] * xc) / a[0];
+            for (std::size_t i = 0; i < n - 1; ++i)
+                s[i * stride + c] = s[(i + 1) * stride + c] + b[i + 1] * xc - a[i + 1] * yc;
+            s[(n - 1) * stride + c] = b[n] * xc - a[n] * yc;
+            y[c] = yc;
+        }
+    }
+
+#ifdef MAHI_FILTER_X86
+
+    /// Four outputs per iteration. Uses separate multiplies and adds (not FMA)
+    /// so results are identical to fir_block_scalar.
+    MAHI_TARGET_AVX
+    void fir_block_avx(const double* b, std::size_t n, const double* x, double* w, std::size_t count) {
+        std::size_t k = 0;
+        for (; k + 4 <= count; k += 4) {
+            __m256d acc = _mm256_mul_pd(_mm256_set1_pd(b[0]), _mm256_loadu_pd(x + k));
+            for (std::size_t i = 1; i <= n; ++i)
+                acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_set1_pd(b[i]), _mm256_loadu_pd(x + k - i)));
+            _mm256_storeu_pd(w + k, acc);
+        }
+        // avoid AVX-SSE transition penalties in the (non-VEX) code that follows
+        _mm256_zeroupper();
+        fir_block_scalar(b, n, x + k, w + k, count - k);
+    }
+
+    /// Four channels per iteration, with the same operations as
+    /// bank_update_scalar (and Filter::dir_form_ii_t).
+    MAHI_TARGET_AVX
+    void bank_update_avx(const double* b, const double* a, std::size_t n, double* s, std::size_t stride,
+                         const double* x, double* y, std::size_t first, std::size_t channels) {
+        const __m256d a0 = _mm256_set1_pd(a[0]);
+        std::size_t c = first;
+        for (; c + 4 <= channels; c += 4) {
+            const __m256d xc = _mm256_loadu_pd(x + c);
+            const __m256d yc = _mm256_div_pd(_mm256_add_pd(_mm256_loadu_pd(s + c),
+                                                           _mm256_mul_pd(_mm256_set1_pd(b[0]), xc)), a0);
+            for (std::size_t i = 0; i < n - 1; ++i) {
+                __m256d si = _mm256_add_pd(_mm256_loadu_pd(s + (i + 1) * stride + c),
+                                           _mm256_mul_pd(_mm256_set1_pd(b[i + 1]), xc));
+                si = _mm256_sub_pd(si, _mm256_mul_pd(_mm256_set1_pd(a[i + 1]), yc));
+                _mm256_storeu_pd(s + i * stride + c, si);
+            }
+            _mm256_storeu_pd(s + (n - 1) * stride + c,
+                             _mm256_sub_pd(_mm256_mul_pd(_mm256_set1_pd(b[n]), xc),
+                                           _mm256_mul_pd(_mm256_set1_pd(a[n]), yc)));
+            _mm256_storeu_pd(y + c, yc);
+        }
+        _mm256_zeroupper();
+        bank_update_scalar(b, a, n, s, stride, x, y, c, channels);
+    }
+
+    bool cpu_has_avx() {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx");
+#elif defined(_MSC_VER)
+        // AVX supported by the CPU and its registers saved by the OS
+        int info[4];
+        __cpuid(info, 1);
+        const bool avx     = (info[2] & (1 << 28)) != 0;
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        return avx && osxsave && (_xgetbv(0) & 0x6) == 0x6;
+#else
+        return false;
+#endif
+    }
+
+#endif // MAHI_FILTER_X86
+
+    typedef void (*FirBlockFunc)(const double*, std::size_t, const double*, double*, std::size_t);
+
+    FirBlockFunc select_fir_block() {
+#ifdef MAHI_FILTER_X86
+        if (cpu_has_avx())
+            return fir_block_avx;
+#endif
+        return fir_block_scalar;
+    }
+
+    const FirBlockFunc g_fir_block = select_fir_block();
+
+    typedef void (*BankUpdateFunc)(const double*, const double*, std::size_t, double*, std::size_t,
+                                   const double*, double*, std::size_t, std::size_t);
+
+    BankUpdateFunc select_bank_update() {
+#ifdef MAHI_FILTER_X86
+        if (cpu_has_avx())
+            return bank_update_avx;
+#endif
+        return bank_update_scalar;
+    }
+
+    const BankUpdateFunc g_bank_update = select_bank_update();
+
+    /// Denominator recursion of a fixed order N with the output history in
+    /// locals. The a[1] term is applied last to keep it off the critical path,
+    /// and the 1 / a[0] scaling is skipped when a[0] == 1 (Unit).
+    template <std::size_t N, bool Unit>
+    void recurse_fixed(const double* a, double inv_a0, const double* w, double* y, std::size_t count) {
+        double h[N];  // h[i] = y[k - 1 - i]
+        for (std::size_t i = 0; i < N; ++i)
+            h[i] = 0.0;
+        for (std::size_t k = 0; k < count; ++k) {
+            double acc = w[k];
+            for (std::size_t i = N; i >= 2; --i)
+                acc -= a[i] * h[i - 1];
+            acc = Unit ? acc - a[1] * h[0] : (acc - a[1] * h[0]) * inv_a0;
+            for (std::size_t i = N - 1; i > 0; --i)
+                h[i] = h[i - 1];
+            h[0] = acc;
+            y[k] = acc;
+        }
+    }
+
+    void recurse_generic(const double* a, std::size_t n, double inv_a0, const double* w, double* y, std::size_t count) {
+        for (std::size_t k = 0; k < count; ++k) {
+            double acc = w[k];
+            for (std::size_t i = std::min(k, n); i >= 1; --i)
+                acc -= a[i] * y[k - i];
+            y[k] = acc * inv_a0;
+        }
+    }
+
+    template <bool Unit>
+    void recurse(const double* a, std::size_t n, double inv_a0, const double* w, double* y, std::size_t count) {
+        switch (n) {
+            case 1: recurse_fixed<1, Unit>(a, inv_a0, w, y, count); break;
+            case 2: recurse_fixed<2, Unit>(a, inv_a0, w, y, count); break;
+            case 3: recurse_fixed<3, Unit>(a, inv_a0, w, y, count); break;
+            case 4: recurse_fixed<4, Unit>(a, inv_a0, w, y, count); break;
+            case 5: recurse_fixed<5, Unit>(a, inv_a0, w, y, count); break;
+            case 6: recurse_fixed<6, Unit>(a, inv_a0, w, y, count); break;
+            case 7: recurse_fixed<7, Unit>(a, inv_a0, w, y, count); break;
+            case 8: recurse_fixed<8, Unit>(a, inv_a0, w, y, count); break;
+            default: recurse_generic(a, n, inv_a0, w, y, count); break;
+        }
+    }
+
+} // namespace
+
+bool filter_simd_enabled() {
+#ifdef MAHI_FILTER_X86
+    return g_fir_block == fir_block_avx;
+#else
+    return false;
+#endif
+}
+
+void fir_block(const double* b, std::size_t n, const double* x, double* w, std::size_t count) {
+    g_fir_block(b, n, x, w, count);
+}
+
+void bank_update(const double* b, const double* a, std::size_t n, double* s, std::size_t stride,
+                 const double* x, double* y, std::size_t channels)
+{
+    g_bank_update(b, a, n, s, stride, x, y, 0, channels);
+}
+
+// Each block is filtered as if it started from rest, with the direct form II
+// transposed state s added to its first n outputs (s[k] is exactly the
+// contribution of earlier samples to output k). The state after the block is
+// then rebuilt from the block's last n inputs and outputs.
+void iir_block(const double* b, const double* a, std::size_t n, double* s,
+               const double* in, double* out, std::size_t count)
+{
+    double xb[FILTER_BLOCK_MAX_ORDER + FILTER_BLOCK_SIZE];  // n zeros followed by the block's inputs
+    double w[FILTER_BLOCK_SIZE];                            // numerator output
+    double s_next[FILTER_BLOCK_MAX_ORDER];
+    const double inv_a0 = 1.0 / a[0];
+    std::fill(xb, xb + n, 0.0);
+    while (count > 0) {
+        const std::size_t N = std::min(count, FILTER_BLOCK_SIZE);
+        std::copy(in, in + N, xb + n);
+        fir_block(b, n, xb + n, w, N);
+        for (std::size_t k = 0; k < std::min(n, N); ++k)
+            w[k] += s[k];
+        if (a[0] == 1.0)
+            recurse<true>(a, n, inv_a0, w, out, N);
+        else
+            recurse<false>(a, n, inv_a0, w, out, N);
+        for (std::size_t j = 0; j < n; ++j) {
+            double acc = j + N < n ? s[j + N] : 0.0;
+            // sample m = N + j - i contributes to s[j] through coefficient i
+            for (std::size_t i = j + 1; i <= n; ++i) {
+                if (N + j >= i) {
+                    const std::size_t m = N + j - i;
+                    acc += b[i] * xb[n + m] - a[i] * out[m];
+                }
+            }
+            s_next[j] = acc;
+        }
+        std::copy(s_next, s_next + n, s);
+        in    += N;
+        out   += N;
+        count -= N;
+    }
+}
+
+} // namespace detail
+} // namespace util
+} // namespace mahi
@@ -0,0 +1,18 @@
+#include <Mahi/Util/Logging/Log.hpp>
+#include <Mahi/Util/Math/FixedFilter.hpp>
+
+namespace mahi {
+namespace util {
+namespace detail {
+
+bool check_filter_order(const Filter& filter, std::size_t order) {
+    if (filter.get_a().size() != order + 1 || filter.get_b().size() != order + 1) {
+        LOG(Error) << "Filter of order " << filter.get_a().size() - 1 << " does not match FixedFilter order " << order;
+        return false;
+    }
+    return true;
+}
+
+} // namespace detail
+} // namespace util
+} // namespace mahi
@@ -0,0 +1,297 @@
+#include <Mahi/Util/Concurrency/ThreadPool.hpp>
+#include <Mahi/Util/Logging/Log.hpp>
+#include <Mahi/Util/Math/Butterworth.hpp>
+#include <Mahi/Util/Math/Signal.hpp>
+#include <Mahi/Util/Math/Detail/FilterKernels.hpp>
+#include <algorithm>
+
+namespace mahi {
+namespace util {
+
+namespace {
+
+    /// Runs a transfer function (b, a) in direct form II transposed, using the
+    /// block kernels for orders up to FILTER_BLOCK_MAX_ORDER
+    class TfRunner {
+    public:
+        TfRunner(const Filter& filter) :
+            b_(filter.get_b()), a_(filter.get_a()), n_(a_.size() - 1), s_(n_, 0.0), zi_(n_, 0.0)
+        {
+            const double a0 = a_[0];
+            for (std::size_t i = 0; i <= n_; ++i) {
+                b_[i] /= a0;
+                a_[i] /= a0;
+            }
+            // steady state for a unit input: y = H(1) and s[i] = sum(b[j] - a[j] * y, j = i+1..n)
+            // (with a pole at z = 1 there is none, so start from rest)
+            double sum_b = 0, sum_a = 0;
+            for (std::size_t i = 0; i <= n_; ++i) {
+                sum_b += b_[i];
+                sum_a += a_[i];
+            }
+            if (sum_a != 0) {
+                const double y = sum_b / sum_a;
+                double acc = 0;
+                for (std::size_t j = n_; j >= 1; --j) {
+                    acc += b_[j] - a_[j] * y;
+                    zi_[j - 1] = acc;
+                }
+            }
+        }
+
+        /// Default edge padding
+        std::size_t padding() const { return 3 * (n_ + 1); }
+
+        /// Sets the state to the steady state for a constant input level
+        void init(double level) {
+            for (std::size_t i = 0; i < n_; ++i)
+                s_[i] = zi_[i] * level;
+        }
+
+        /// Filters count samples of x in place
+        void run(double* x, std::size_t count) {
+            if (n_ <= detail::FILTER_BLOCK_MAX_ORDER) {
+                detail::iir_block(b_.data(), a_.data(), n_, s_.data(), x, x, count);
+                return;
+            }
+            for (std::size_t k = 0; k < count; ++k) {
+                const double u = x[k];
+                const double y = s_[0] + b_[0] * u;
+                for (std::size_t i = 0; i < n_ - 1; ++i)
+                    s_[i] = s_[i + 1] + b_[i + 1] * u - a_[i + 1] * y;
+                s_[n_ - 1] = b_[n_] * u - a_[n_] * y;
+                x[k] = y;
+            }
+        }
+
+    private:
+        std::vector<double> b_, a_;
+        std::size_t n_;
+        std::vector<double> s_, zi_;
+    };
+
+    /// Runs a cascade of second-order sections, each in direct form II transposed
+    class SosRunner {
+    public:
+        SosRunner(const std::vector<Sos>& sos) : sections_(sos.size()), s_(sos.size()) {
+            for (std::size_t i = 0; i < sos.size(); ++i) {
+                const double a0 = sos[i][3];
+                sections_[i] = {{sos[i][0] / a0, sos[i][1] / a0, sos[i][2] / a0, sos[i][4] / a0, sos[i][5] / a0}};
+            }
+        }
+
+        /// Default edge padding
+        std::size_t padding() const { return 3 * (2 * sections_.size() + 1); }
+
+        /// Sets each section to its steady state for a constant input level
+        void init(double level) {
+            for (std::size_t i = 0; i < sections_.size(); ++i) {
+                const Section& c = sections_[i];
+                const double den = 1.0 + c[3] + c[4];
+                const double y = den != 0 ? level * (c[0] + c[1] + c[2]) / den : 0.0;
+                s_[i][1] = c[2] * level - c[4] * y;
+                s_[i][0] = c[1] * level - c[3] * y + s_[i][1];
+                level = y;
+            }
+        }
+
+        /// Filters count samples of x in place, sample by sample through all
+        /// sections so their latency chains overlap
+        void run(double* x, std::size_t count) {
+            const std::size_t ns = sections_.size();
+            for (std::size_t k = 0; k < count; ++k) {
+                double y = x[k];
+                for (std::size_t i = 0; i < ns; ++i) {
+                    const Section& c = sections_[i];
+                    std::array<double, 2>& s = s_[i];
+                    const double u = y;
+                    y    = c[0] * u + s[0];
+                    s[0] = c[1] * u - c[3] * y + s[1];
+                    s[1] = c[2] * u - c[4] * y;
+                }
+                x[k] = y;
+            }
+        }
+
+    private:
+        typedef std::array<double, 5> Section;  ///< {b0, b1, b2, a1, a2}
+        std::vector<Section> sections_;
+        std::vector<std::array<double, 2>> s_;
+    };
+
+    bool check_filter(const Filter& filter) {
+        if (filter.get_a().size() < 2 || filter.get_a().size() != filter.get_b().size() || filter.get_a()[0] == 0) {
+            LOG(Error) << "filtfilt requires a valid Filter";
+            return false;
+        }
+        return true;
+    }
+
+    bool check_sos(const std::vector<Sos>& sos) {
+        for (std::size_t i = 0; i < sos.size(); ++i) {
+            if (sos[i][3] == 0) {
+                LOG(Error) << "Second-order section " << i << " has a0 == 0";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Returns in with pad samples of odd reflection (about the end samples) at both ends
+    std::vector<double> odd_extend(const double* in, std::size_t n, std::size_t pad) {
+        std::vector<double> ext(n + 2 * pad);
+        for (std::size_t i = 0; i < pad; ++i) {
+            ext[i]           = 2 * in[0] - in[pad - i];
+            ext[pad + n + i] = 2 * in[n - 1] - in[n - 2 - i];
+        }
+        std::copy(in, in + n, ext.begin() + pad);
+        return ext;
+    }
+
+    /// Filters x forward from the steady state for level, then backward from
+    /// the steady state for the last forward output
+    template <typename Runner>
+    void forward_backward(Runner& runner, double* x, std::size_t n, double level) {
+        runner.init(level);
+        runner.run(x, n);
+        std::reverse(x, x + n);
+        runner.init(x[0]);
+        runner.run(x, n);
+        std::reverse(x, x + n);
+    }
+
+    template <typename Runner>
+    void filtfilt_impl(Runner& runner, const double* in, double* out, std::size_t n) {
+        if (n == 0)
+            return;
+        const std::size_t pad = (std::min)(runner.padding(), n - 1);
+        std::vector<double> ext = odd_extend(in, n, pad);
+        forward_backward(runner, ext.data(), ext.size(), ext[0]);
+        std::copy(ext.begin() + pad, ext.begin() + pad + n, out);
+    }
+
+    /// Calls func on each channel, in parallel if possible
+    void for_channels(std::vector<std::vector<double>>& channels, ThreadPool* pool,
+                      const std::function<void(std::vector<double>&)>& func) {
+        const std::function<void(std::size_t)> task = [&](std::size_t i) { func(channels[i]); };
+        if (pool) {
+            pool->parallel_for(channels.size(), task);
+        }
+        else if (channels.size() > 1 && ThreadPool::hardware_threads() > 1) {
+            ThreadPool local((std::min)(channels.size(), ThreadPool::hardware_threads()));
+            local.parallel_for(channels.size(), task);
+        }
+        else {
+            for (std::size_t i = 0; i < channels.size(); ++i)
+                task(i);
+        }
+    }
+
+    std::size_t gcd(std::size_t a, std::size_t b) {
+        while (b != 0) {
+            std::size_t t = a % b;
+            a = b;
+            b = t;
+        }
+        return a;
+    }
+
+} // namespace
+
+void filtfilt(const Filter& filter, const double* in, double* out, std::size_t n) {
+    if (!check_filter(filter))
+        return;
+    TfRunner runner(filter);
+    filtfilt_impl(runner, in, out, n);
+}
+
+void filtfilt(const std::vector<Sos>& sos, const double* in, double* out, std::size_t n) {
+    if (!check_sos(sos))
+        return;
+    SosRunner runner(sos);
+    filtfilt_impl(runner, in, out, n);
+}
+
+std::vector<double> filtfilt(const Filter& filter, const std::vector<double>& x) {
+    std::vector<double> y(x.size());
+    filtfilt(filter, x.data(), y.data(), x.size());
+    return y;
+}
+
+std::vector<double> filtfilt(const std::vector<Sos>& sos, const std::vector<double>& x) {
+    std::vector<double> y(x.size());
+    filtfilt(sos, x.data(), y.data(), x.size());
+    return y;
+}
+
+void filtfilt(const Filter& filter, std::vector<std::vector<double>>& channels, ThreadPool* pool) {
+    if (!check_filter(filter))
+        return;
+    for_channels(channels, pool, [&](std::vector<double>& x) {
+        TfRunner runner(filter);
+        filtfilt_impl(runner, x.data(), x.data(), x.size());
+    });
+}
+
+void filtfilt(const std::vector<Sos>& sos, std::vector<std::vector<double>>& channels, ThreadPool* pool) {
+    if (!check_sos(sos))
+        return;
+    for_channels(channels, pool, [&](std::vector<double>& x) {
+        SosRunner runner(sos);
+        filtfilt_impl(runner, x.data(), x.data(), x.size());
+    });
+}
+
+std::vector<double> decimate(const std::vector<double>& x, std::size_t q, std::size_t order) {
+    if (q == 0) {
+        LOG(Error) << "Decimation factor must be at least 1";
+        return std::vector<double>();
+    }
+    if (q == 1)
+        return x;
+    std::vector<double> y = filtfilt(Butterworth::design_sos(order, 0.8 / q), x);
+    std::vector<double> out;
+    out.reserve((x.size() + q - 1) / q);
+    for (std::size_t i = 0; i < y.size(); i += q)
+        out.push_back(y[i]);
+    return out;
+}
+
+std::vector<double> resample(const std::vector<double>& x, std::size_t up, std::size_t down, std::size_t order) {
+    if (up == 0 || down == 0) {
+        LOG(Error) << "Resampling factors must be at least 1";
+        return std::vector<double>();
+    }
+    const std::size_t g = gcd(up, down);
+    up   /= g;
+    down /= g;
+    if (up == 1)
+        return decimate(x, down, order);
+    if (x.empty())
+        return x;
+    SosRunner runner(Butterworth::design_sos(order, 0.8 / (std::max)(up, down)));
+    // pad at the original rate, then upsample by inserting zeros (scaled by
+    // up to preserve the signal level after lowpass filtering)
+    const std::size_t n   = x.size();
+    const std::size_t pad = (std::min)(runner.padding(), n - 1);
+    std::vector<double> ext = odd_extend(x.data(), n, pad);
+    std::vector<double> u(ext.size() * up, 0.0);
+    for (std::size_t k = 0; k < ext.size(); ++k)
+        u[k * up] = static_cast<double>(up) * ext[k];
+    forward_backward(runner, u.data(), u.size(), ext[0]);
+    std::vector<double> out((n * up + down - 1) / down);
+    for (std::size_t j = 0; j < out.size(); ++j)
+        out[j] = u[pad * up + j * down];
+    return out;
+}
+
+std::vector<double> resample(const std::vector<double>& x, Frequency from, Frequency to, std::size_t order) {
+    if (from.as_hertz() <= 0 || to.as_hertz() <= 0) {
+        LOG(Error) << "Resampling frequencies must be positive whole hertz";
+        return std::vector<double>();
+    }
+    return resample(x, static_cast<std::size_t>(to.as_hertz()), static_cast<std::size_t>(from.as_hertz()), order);
+}
+
+} // namespace util
+} // namespace mahi
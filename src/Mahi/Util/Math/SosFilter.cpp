@@ -0,0 +1,134 @@
+#include <Mahi/Util/Logging/Log.hpp>
+#include <Mahi/Util/Math/SosFilter.hpp>
+#include <algorithm>
+
+namespace mahi {
+namespace util {
+
+template <typename T>
+SosFilter<T>::SosFilter(const std::vector<Sos>& sos, unsigned int seeding) :
+    value_(0),
+    has_seeding_(seeding > 0),
+    first_update_(true),
+    seed_count_(seeding)
+{
+    set_sos(sos);
+}
+
+template <typename T>
+T SosFilter<T>::update(const T x) {
+    if (first_update_) {
+        if (has_seeding_) {
+            seed(x, seed_count_);
+        }
+        first_update_ = false;
+    }
+    T y = x;
+    for (std::size_t i = 0; i < sections_.size(); ++i) {
+        const Section& c = sections_[i];
+        std::array<T, 2>& s = s_[i];
+        const T u = y;
+        y    = c.b0 * u + s[0];
+        s[0] = c.b1 * u - c.a1 * y + s[1];
+        s[1] = c.b2 * u - c.a2 * y;
+    }
+    value_ = y;
+    return value_;
+}
+
+template <typename T>
+void SosFilter<T>::process(const T* in, T* out, std::size_t n) {
+    if (n == 0)
+        return;
+    if (first_update_) {
+        if (has_seeding_) {
+            seed(in[0], seed_count_);
+        }
+        first_update_ = false;
+    }
+    // sample by sample through all sections, so that the sections' latency
+    // chains overlap rather than running one after another
+    const std::size_t ns = sections_.size();
+    for (std::size_t k = 0; k < n; ++k) {
+        T y = in[k];
+        for (std::size_t i = 0; i < ns; ++i) {
+            const Section& c = sections_[i];
+            std::array<T, 2>& s = s_[i];
+            const T u = y;
+            y    = c.b0 * u + s[0];
+            s[0] = c.b1 * u - c.a1 * y + s[1];
+            s[1] = c.b2 * u - c.a2 * y;
+        }
+        out[k] = y;
+    }
+    value_ = out[n - 1];
+}
+
+template <typename T>
+T SosFilter<T>::get_value() const {
+    return value_;
+}
+
+template <typename T>
+void SosFilter<T>::reset() {
+    for (std::size_t i = 0; i < s_.size(); ++i)
+        s_[i][0] = s_[i][1] = 0;
+    first_update_ = true;
+}
+
+template <typename T>
+std::size_t SosFilter<T>::get_sections() const {
+    return sections_.size();
+}
+
+template <typename T>
+std::vector<Sos> SosFilter<T>::get_sos() const {
+    std::vector<Sos> sos(sections_.size());
+    for (std::size_t i = 0; i < sections_.size(); ++i) {
+        const Section& c = sections_[i];
+        sos[i] = {{c.b0, c.b1, c.b2, 1.0, c.a1, c.a2}};
+    }
+    return sos;
+}
+
+template <typename T>
+void SosFilter<T>::set_seeding(unsigned int seeding) {
+    has_seeding_ = (seeding > 0);
+    seed_count_ = seeding;
+}
+
+template <typename T>
+void SosFilter<T>::set_sos(const std::vector<Sos>& sos) {
+    for (std::size_t i = 0; i < sos.size(); ++i) {
+        if (sos[i][3] == 0) {
+            LOG(Error) << "Second-order section " << i << " has a0 == 0";
+            return;
+        }
+    }
+    // normalize in double precision before rounding to T
+    sections_.resize(sos.size());
+    for (std::size_t i = 0; i < sos.size(); ++i) {
+        const double a0 = sos[i][3];
+        Section& c = sections_[i];
+        c.b0 = static_cast<T>(sos[i][0] / a0);
+        c.b1 = static_cast<T>(sos[i][1] / a0);
+        c.b2 = static_cast<T>(sos[i][2] / a0);
+        c.a1 = static_cast<T>(sos[i][4] / a0);
+        c.a2 = static_cast<T>(sos[i][5] / a0);
+    }
+    s_.resize(sos.size());
+    reset();
+}
+
+template <typename T>
+void SosFilter<T>::seed(const T x, const unsigned int iterations) {
+    first_update_ = false;
+    for (unsigned int i = 0; i < iterations; ++i)
+        update(x);
+}
+
+template class SosFilter<float>;
+template class SosFilter<double>;
+
+} // namespace util
+} // namespace mahi
@@ -0,0 +1,335 @@
+#include <Mahi/Util/Realtime.hpp>
+#include <Mahi/Util/System.hpp>
+#include <fmt/format.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#include <malloc.h>
+#include <windows.h>
+#else
+#include <alloca.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#ifndef PR_SET_THP_DISABLE
+#define PR_SET_THP_DISABLE 41
+#endif
+#ifndef SCHED_DEADLINE
+#define SCHED_DEADLINE 6
+#endif
+#endif
+
+namespace mahi {
+namespace util {
+
+namespace {
+
+    const std::size_t PAGE_SIZE_GUESS = 4096;
+
+    std::string errno_string(const char* what, int err) {
+        return fmt::format("{}: {}", what, std::strerror(err));
+    }
+
+    /// Touches size bytes of the stack so its pages are mapped (and locked, if
+    /// mlockall is in effect) before the real-time loop needs them
+#if defined(__GNUC__) || defined(__clang__)
+    __attribute__((noinline))
+#elif defined(_MSC_VER)
+    __declspec(noinline)
+#endif
+    void touch_stack(std::size_t size) {
+#ifdef _WIN32
+        volatile char* stack = static_cast<volatile char*>(_alloca(size));
+#else
+        volatile char* stack = static_cast<volatile char*>(alloca(size));
+#endif
+        for (std::size_t i = 0; i < size; i += PAGE_SIZE_GUESS)
+            stack[i] = 0;
+    }
+
+#ifdef __linux__
+    /// Mirrors the kernel's struct sched_attr (glibc has no wrapper)
+    struct SchedAttr {
+        uint32 size;
+        uint32 sched_policy;
+        uint64 sched_flags;
+        int32  sched_nice;
+        uint32 sched_priority;
+        uint64 sched_runtime;
+        uint64 sched_deadline;
+        uint64 sched_period;
+    };
+
+    /// Returns the usable stack size of the calling thread, or 0 if unknown
+    std::size_t stack_size() {
+        pthread_attr_t attr;
+        if (pthread_getattr_np(pthread_self(), &attr) != 0)
+            return 0;
+        void* addr = nullptr;
+        std::size_t size = 0;
+        pthread_attr_getstack(&attr, &addr, &size);
+        pthread_attr_destroy(&attr);
+        return size;
+    }
+#endif
+
+    RealtimeStatus::Result set_scheduling(const RealtimeConfig& config, std::vector<std::string>& messages) {
+        if (config.policy == RealtimeConfig::None)
+            return RealtimeStatus::Skipped;
+#ifdef _WIN32
+        if (config.policy == RealtimeConfig::Deadline) {
+            messages.push_back("scheduling: Deadline policy requires Linux");
+            return RealtimeStatus::Unsupported;
+        }
+        if (!SetPriorityClass(GetCurrentProcess(), REALTIME_PRIORITY_CLASS) ||
+            !SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL)) {
+            messages.push_back(fmt::format("scheduling: {}", get_last_os_error()));
+            return RealtimeStatus::Failed;
+        }
+        return RealtimeStatus::Ok;
+#elif defined(__linux__)
+        if (config.policy == RealtimeConfig::Deadline) {
+            SchedAttr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size           = sizeof(attr);
+            attr.sched_policy   = SCHED_DEADLINE;
+            attr.sched_runtime  = static_cast<uint64>(config.runtime.as_nanoseconds());
+            attr.sched_deadline = static_cast<uint64>(config.deadline.as_nanoseconds());
+            attr.sched_period   = static_cast<uint64>(config.period.as_nanoseconds());
+            if (::syscall(SYS_sched_setattr, 0, &attr, 0) != 0) {
+                messages.push_back(errno_string("scheduling: sched_setattr(SCHED_DEADLINE)", errno));
+                return RealtimeStatus::Failed;
+            }
+            return RealtimeStatus::Ok;
+        }
+#endif
+#ifndef _WIN32
+        const int policy = config.policy == RealtimeConfig::RoundRobin ? SCHED_RR : SCHED_FIFO;
+        const int lo = sched_get_priority_min(policy);
+        const int hi = sched_get_priority_max(policy);
+        sched_param params;
+        params.sched_priority = config.priority < 0 ? hi : (config.priority < lo ? lo : (config.priority > hi ? hi : config.priority));
+        const int ret = pthread_setschedparam(pthread_self(), policy, &params);
+        if (ret != 0) {
+            messages.push_back(errno_string("scheduling: pthread_setschedparam", ret));
+            return RealtimeStatus::Failed;
+        }
+        return RealtimeStatus::Ok;
+#endif
+    }
+
+    RealtimeStatus::Result set_affinity(const RealtimeConfig& config, std::vector<std::string>& messages) {
+        std::vector<int> cpus = config.cpus;
+        if (cpus.empty() && config.isolated_cpus) {
+            cpus = get_isolated_cpus();
+            if (cpus.empty()) {
+                messages.push_back("affinity: no isolated CPUs (boot with isolcpus=)");
+                return RealtimeStatus::Failed;
+            }
+        }
+        if (cpus.empty())
+            return RealtimeStatus::Skipped;
+#ifdef _WIN32
+        DWORD_PTR mask = 0;
+        for (int cpu : cpus) {
+            if (cpu >= 0 && cpu < 64)
+                mask |= DWORD_PTR(1) << cpu;
+        }
+        if (mask == 0 || SetThreadAffinityMask(GetCurrentThread(), mask) == 0) {
+            messages.push_back(fmt::format("affinity: {}", get_last_os_error()));
+            return RealtimeStatus::Failed;
+        }
+        return RealtimeStatus::Ok;
+#elif defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : cpus) {
+            if (cpu >= 0 && cpu < CPU_SETSIZE)
+                CPU_SET(cpu, &set);
+        }
+        const int ret = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        if (ret != 0) {
+            messages.push_back(errno_string("affinity: pthread_setaffinity_np", ret));
+            return RealtimeStatus::Failed;
+        }
+        return RealtimeStatus::Ok;
+#else
+        messages.push_back("affinity: not supported on this platform");
+        return RealtimeStatus::Unsupported;
+#endif
+    }
+
+    RealtimeStatus::Result lock_memory(const RealtimeConfig& config, std::vector<std::string>& messages) {
+        if (!config.lock_memory)
+            return RealtimeStatus::Skipped;
+#ifdef _WIN32
+        messages.push_back("memory_lock: not supported on Windows");
+        return RealtimeStatus::Unsupported;
+#else
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+            messages.push_back(errno_string("memory_lock: mlockall", errno));
+            return RealtimeStatus::Failed;
+        }
+        return RealtimeStatus::Ok;
+#endif
+    }
+
+    RealtimeStatus::Result prefault_stack(const RealtimeConfig& config, std::vector<std::string>& messages) {
+        if (config.prefault_stack == 0)
+            return RealtimeStatus::Skipped;
+        std::size_t size = config.prefault_stack;
+#ifdef __linux__
+        // leave room for the frames above us and the guard page
+        const std::size_t available = stack_size();
+        if (available > 0 && size + 64 * 1024 > available) {
+            size = available > 64 * 1024 ? available - 64 * 1024 : 0;
+            messages.push_back(fmt::format("stack_prefault: clamped to {} bytes (thread stack is {} bytes)", size, available));
+        }
+#endif
+        touch_stack(size);
+        return RealtimeStatus::Ok;
+    }
+
+    RealtimeStatus::Result prefault_heap(const RealtimeConfig& config, std::vector<std::string>& messages) {
+        if (config.prefault_heap == 0)
+            return RealtimeStatus::Skipped;
+#if defined(__linux__) && defined(__GLIBC__)
+        // keep freed memory in the heap instead of returning it to the OS, and
+        // serve large allocations from the heap instead of fresh mmaps
+        if (mallopt(M_TRIM_THRESHOLD, -1) == 0 || mallopt(M_MMAP_MAX, 0) == 0) {
+            messages.push_back("heap_prefault: mallopt failed");
+            return RealtimeStatus::Failed;
+        }
+#endif
+        char* heap = static_cast<char*>(std::malloc(config.prefault_heap));
+        if (!heap) {
+            messages.push_back(fmt::format("heap_prefault: failed to allocate {} bytes", config.prefault_heap));
+            return RealtimeStatus::Failed;
+        }
+        for (std::size_t i = 0; i < config.prefault_heap; i += PAGE_SIZE_GUESS)
+            static_cast<volatile char*>(heap)[i] = 0;
+        std::free(heap);
+#if !(defined(__linux__) && defined(__GLIBC__))
+        messages.push_back("heap_prefault: touched, but the allocator may return the pages to the OS");
+#endif
+        return RealtimeStatus::Ok;
+    }
+
+    RealtimeStatus::Result disable_thp(const RealtimeConfig& config, std::vector<std::string>& messages) {
+        if (!config.disable_thp)
+            return RealtimeStatus::Skipped;
+#ifdef __linux__
+        if (prctl(PR_SET_THP_DISABLE, 1, 0, 0, 0) != 0) {
+            messages.push_back(errno_string("thp: prctl(PR_SET_THP_DISABLE)", errno));
+            return RealtimeStatus::Failed;
+        }
+        return RealtimeStatus::Ok;
+#else
+        messages.push_back("thp: transparent huge pages are Linux only");
+        return RealtimeStatus::Unsupported;
+#endif
+    }
+
+    const char* result_name(RealtimeStatus::Result r) {
+        switch (r) {
+            case RealtimeStatus::Skipped: return "skipped";
+            case RealtimeStatus::Ok:      return "ok";
+            case RealtimeStatus::Failed:  return "FAILED";
+            default:                      return "unsupported";
+        }
+    }
+
+} // namespace
+
+RealtimeConfig::RealtimeConfig() :
+    policy(Fifo),
+    priority(-1),
+    runtime(Time::Zero),
+    deadline(Time::Zero),
+    period(Time::Zero),
+    isolated_cpus(false),
+    lock_memory(true),
+    prefault_stack(256 * 1024),
+    prefault_heap(0),
+    disable_thp(true)
+{
+}
+
+RealtimeStatus::RealtimeStatus() :
+    scheduling(Skipped),
+    affinity(Skipped),
+    memory_lock(Skipped),
+    stack_prefault(Skipped),
+    heap_prefault(Skipped),
+    thp(Skipped)
+{
+}
+
+bool RealtimeStatus::ok() const {
+    return scheduling != Failed && affinity != Failed && memory_lock != Failed &&
+           stack_prefault != Failed && heap_prefault != Failed && thp != Failed;
+}
+
+std::string RealtimeStatus::summary() const {
+    std::string out = fmt::format("scheduling={} affinity={} memory_lock={} stack_prefault={} heap_prefault={} thp={}",
+                                  result_name(scheduling), result_name(affinity), result_name(memory_lock),
+                                  result_name(stack_prefault), result_name(heap_prefault), result_name(thp));
+    for (auto& m : messages)
+        out += "\n  " + m;
+    return out;
+}
+
+RealtimeStatus configure_realtime(const RealtimeConfig& config) {
+    RealtimeStatus status;
+    // pin first so pages are faulted in on the NUMA node the thread will run
+    // on, and change scheduling last so prefaulting doesn't starve other threads
+    status.affinity       = set_affinity(config, status.messages);
+    status.thp            = disable_thp(config, status.messages);
+    status.memory_lock    = lock_memory(config, status.messages);
+    status.heap_prefault  = prefault_heap(config, status.messages);
+    status.stack_prefault = prefault_stack(config, status.messages);
+    status.scheduling     = set_scheduling(config, status.messages);
+    return status;
+}
+
+std::vector<int> get_isolated_cpus() {
+    std::vector<int> cpus;
+#ifdef __linux__
+    // format is a list of ranges, e.g. "2-3,6"
+    std::ifstream file("/sys/devices/system/cpu/isolated");
+    std::string list;
+    if (!file || !std::getline(file, list))
+        return cpus;
+    std::size_t pos = 0;
+    while (pos < list.size()) {
+        std::size_t end = list.find(',', pos);
+        if (end == std::string::npos)
+            end = list.size();
+        const std::string range = list.substr(pos, end - pos);
+        const std::size_t dash = range.find('-');
+        if (!range.empty()) {
+            const int lo = std::atoi(range.c_str());
+            const int hi = dash == std::string::npos ? lo : std::atoi(range.c_str() + dash + 1);
+            for (int cpu = lo; cpu <= hi; ++cpu)
+                cpus.push_back(cpu);
+        }
+        pos = end + 1;
+    }
+#endif
+    return cpus;
+}
+
+} // namespace util
+} // namespace mahi
@@ -184,18 +184,18 @@ void sleep(Time duration) {
             // ::Sleep(duration.as_milliseconds()); // low-resolution method
             HANDLE timer;
             LARGE_INTEGER ft;
-            ft.QuadPart = -(10 * duration.as_microseconds());
+            ft.QuadPart = -(duration.as_nanoseconds() / 100);
             timer = CreateWaitableTimer(NULL, TRUE, NULL);
             SetWaitableTimer(timer, &ft, 0, NULL, NULL, 0);
             WaitForSingleObject(timer, INFINITE);
             CloseHandle(timer);
             // timeEndPeriod(tc.wPeriodMin); // to much overhead, not necessary?
         #else
-            uint64 usecs = duration.as_microseconds();
+            uint64 nsecs = duration.as_nanoseconds();
             // Construct the time to wait
             timespec ti;
-            ti.tv_nsec = (usecs % 1000000) * 1000;
-            ti.tv_sec = usecs / 1000000;
+            ti.tv_nsec = nsecs % 1000000000;
+            ti.tv_sec = nsecs / 1000000000;
             // If nanosleep returns -1, we check errno. If it is EINTR
             // nanosleep was interrupted and has set ti to the remaining
             // duration. We continue sleeping until the complete duration
@@ -319,6 +319,33 @@ bool disable_realtime() {
     #endif
 }
 
+bool set_thread_affinity(int cpu) {
+    #ifdef _WIN32
+        if (cpu < 0 || cpu >= 64 || SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu) == 0) {
+            LOG(Error) << "Failed to set thread affinity to CPU " << cpu << ". Code: " << static_cast<int>(GetLastError());
+            return false;
+        }
+        return true;
+    #elif defined(__linux__)
+        if (cpu < 0 || cpu >= CPU_SETSIZE) {
+            LOG(Error) << "Failed to set thread affinity to invalid CPU " << cpu;
+            return false;
+        }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        int ret = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        if (ret != 0) {
+            LOG(Error) << "Failed to set thread affinity to CPU " << cpu << " (" << std::strerror(ret) << ")";
+            return false;
+        }
+        return true;
+    #else
+        LOG(Warning) << "set_thread_affinity() is not supported on this platform";
+        return false;
+    #endif
+}
+
 uint32 get_thread_id() {
     #ifdef _WIN32
     return GetCurrentThreadId();
@@ -1,4 +1,9 @@
 #include <Mahi/Util/Timing/Clock.hpp>
+#include <Mahi/Util/System.hpp>
+
+#if defined(MAHI_TSC_CLOCK) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define MAHI_CLOCK_USE_TSC
+#endif
 
 #ifdef _WIN32
 #include <windows.h>
@@ -8,6 +13,15 @@
 #include <time.h>
 #endif
 
+#ifdef MAHI_CLOCK_USE_TSC
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+#endif
+
 namespace mahi {
 namespace util {
 
@@ -43,15 +57,16 @@ LARGE_INTEGER get_frequency() {
     return frequency;
 }
 
-Time Clock::get_current_time() {
+static int64 os_time_ns() {
     // Get the frequency of the performance counter
     // (it is constant across the program lifetime)
     static LARGE_INTEGER frequency = get_frequency();
     LARGE_INTEGER time;
    // Get the current time
     QueryPerformanceCounter(&time);
-    // Return the current time as microseconds
-    return mahi::util::microseconds(1000000 * time.QuadPart / frequency.QuadPart);
+    // Return the current time as nanoseconds (split to avoid overflowing the product)
+    return time.QuadPart / frequency.QuadPart * 1000000000 +
+           time.QuadPart % frequency.QuadPart * 1000000000 / frequency.QuadPart;
 }
 
 #elif __APPLE__
@@ -60,12 +75,11 @@ Time Clock::get_current_time() {
 // APPLE IMPLEMENTATION
 //==============================================================================
 
-Time Clock::get_current_time() {
+static int64 os_time_ns() {
     static mach_timebase_info_data_t frequency = {0, 0};
     if (frequency.denom == 0)
         mach_timebase_info(&frequency);
-    uint64 nanoseconds = mach_absolute_time() * frequency.numer / frequency.denom;
-    return mahi::util::microseconds(nanoseconds / 1000);
+    return static_cast<int64>(mach_absolute_time() * frequency.numer / frequency.denom);
 }
 
 #else
@@ -74,18 +88,132 @@ Time Clock::get_current_time() {
 // LINUX IMPLEMENTATION
 //==============================================================================
 
-Time Clock::get_current_time() {
+static int64 os_time_ns() {
     // POSIX implementation
     // https://linux.die.net/man/3/clock_gettime
     // https://forums.ni.com/t5/NI-Linux-Real-Time-Discussions/Help-to-solve-a-problem-with-C-on-cRIO-9068/td-p/3469892
     timespec time;
     clock_gettime(CLOCK_MONOTONIC_RAW, &time);
-    return mahi::util::microseconds(static_cast<uint64>(time.tv_sec) * 1000000 + time.tv_nsec / 1000);
+    return static_cast<int64>(time.tv_sec) * 1000000000 + time.tv_nsec;
 }
 
 #endif
 
-} // namespace util
-} // namespace mahi
+//==============================================================================
+// TSC IMPLEMENTATION
+//==============================================================================
+
+#ifdef MAHI_CLOCK_USE_TSC
 
+namespace {
 
+    inline uint64 read_tsc() {
+        return __rdtsc();
+    }
+
+    /// Checks CPUID for an invariant TSC (constant rate, keeps ticking in deep C-states)
+    bool has_invariant_tsc() {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0x80000000);
+        if (static_cast<unsigned int>(info[0]) < 0x80000007)
+            return false;
+        __cpuid(info, 0x80000007);
+        return (info[3] >> 8) & 1;
+#else
+        unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+        if (__get_cpuid_max(0x80000000, nullptr) < 0x80000007)
+            return false;
+        __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+        return (edx >> 8) & 1;
+#endif
+    }
+
+    /// Reads the TSC and OS clock together, keeping the pair with the tightest
+    /// TSC bracket so that preemption between the reads doesn't skew calibration
+    void sample_tsc(uint64& tsc, int64& ns) {
+        uint64 best = ~static_cast<uint64>(0);
+        for (int i = 0; i < 32; ++i) {
+            const uint64 before = read_tsc();
+            const int64  now    = os_time_ns();
+            const uint64 after  = read_tsc();
+            if (after - before < best) {
+                best = after - before;
+                tsc  = before + (after - before) / 2;
+                ns   = now;
+            }
+        }
+    }
+
+    /// Converts TSC ticks to nanoseconds on the OS clock's timeline
+    struct TscClock {
+        TscClock() : valid(false), tsc0(0), ns0(0), mult(0), hz(0) {
+            if (!has_invariant_tsc())
+                return;
+            uint64 tsc_a = 0, tsc_b = 0;
+            int64  ns_a = 0, ns_b = 0;
+            sample_tsc(tsc_a, ns_a);
+            sleep(milliseconds(20));
+            sample_tsc(tsc_b, ns_b);
+            if (tsc_b <= tsc_a || ns_b <= ns_a)
+                return;
+            const double ns_per_tick = static_cast<double>(ns_b - ns_a) / static_cast<double>(tsc_b - tsc_a);
+            // 32.32 fixed point; a TSC slower than 1 GHz would need more integer bits
+            if (ns_per_tick >= 1.0)
+                return;
+            mult  = static_cast<uint64>(ns_per_tick * 4294967296.0 + 0.5);
+            hz    = 1.0e9 / ns_per_tick;
+            tsc0  = tsc_b;
+            ns0   = ns_b;
+            valid = true;
+        }
+
+        int64 now() const {
+            // (delta * mult) >> 32 without a 128-bit product
+            const uint64 delta = read_tsc() - tsc0;
+            return ns0 + static_cast<int64>((delta >> 32) * mult + (((delta & 0xFFFFFFFF) * mult) >> 32));
+        }
+
+        bool   valid;  ///< false if the TSC is missing, variant, or too slow
+        uint64 tsc0;   ///< TSC at calibration
+        int64  ns0;    ///< OS time at calibration [ns]
+        uint64 mult;   ///< ns per tick in 32.32 fixed point
+        double hz;     ///< calibrated TSC frequency
+    };
+
+    const TscClock& get_tsc_clock() {
+        static const TscClock tsc;
+        return tsc;
+    }
+
+} // namespace
+
+#endif // MAHI_CLOCK_USE_TSC
+
+Time Clock::get_current_time() {
+#ifdef MAHI_CLOCK_USE_TSC
+    const TscClock& tsc = get_tsc_clock();
+    if (tsc.valid)
+        return nanoseconds(tsc.now());
+#endif
+    return nanoseconds(os_time_ns());
+}
+
+bool Clock::is_tsc() {
+#ifdef MAHI_CLOCK_USE_TSC
+    return get_tsc_clock().valid;
+#else
+    return false;
+#endif
+}
+
+Frequency Clock::get_tsc_frequency() {
+#ifdef MAHI_CLOCK_USE_TSC
+    if (get_tsc_clock().valid)
+        return hertz(static_cast<int64>(get_tsc_clock().hz));
+#endif
+    return Frequency::Zero;
+}
+
+} // namespace util
+} // namespace mahi
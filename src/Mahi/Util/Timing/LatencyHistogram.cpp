@@ -0,0 +1,65 @@
+#include <Mahi/Util/Timing/LatencyHistogram.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+
+namespace mahi {
+namespace util {
+
+LatencyHistogram::LatencyHistogram() :
+    counts_(BucketCount, 0)
+{
+    reset();
+}
+
+void LatencyHistogram::reset() {
+    std::fill(counts_.begin(), counts_.end(), 0);
+    count_ = 0;
+    sum_   = 0;
+    min_   = (std::numeric_limits<int64>::max)();
+    max_   = (std::numeric_limits<int64>::min)();
+}
+
+double LatencyHistogram::mean() const {
+    return count_ ? static_cast<double>(sum_) / static_cast<double>(count_) : 0.0;
+}
+
+int64 LatencyHistogram::bucket_lower(std::size_t i) {
+    if (i < 64)
+        return static_cast<int64>(i);
+    const int msb = static_cast<int>(i / 32) + 4;
+    return static_cast<int64>((i % 32) + 32) << (msb - 5);
+}
+
+int64 LatencyHistogram::bucket_upper(std::size_t i) {
+    if (i < 64)
+        return static_cast<int64>(i) + 1;
+    const int msb = static_cast<int>(i / 32) + 4;
+    return bucket_lower(i) + (int64(1) << (msb - 5));
+}
+
+int64 LatencyHistogram::percentile(double p) const {
+    if (count_ == 0)
+        return 0;
+    p = (std::max)(0.0, (std::min)(1.0, p));
+    // rank of the requested value (1 based)
+    const uint64 rank = (std::max)(uint64(1), static_cast<uint64>(p * static_cast<double>(count_) + 0.5));
+    uint64 seen = 0;
+    for (std::size_t i = 0; i < BucketCount; ++i) {
+        seen += counts_[i];
+        if (seen >= rank) {
+            // middle of the bucket, within the recorded range
+            const int64 mid = (bucket_lower(i) + bucket_upper(i) - 1) / 2;
+            return (std::max)(min_, (std::min)(max_, mid));
+        }
+    }
+    return max_;
+}
+
+std::string LatencyHistogram::summary() const {
+    return fmt::format("n={} min={:.1f} mean={:.1f} p50={:.1f} p99={:.1f} p99.9={:.1f} max={:.1f} us",
+                       count_, min() / 1000.0, mean() / 1000.0, percentile(0.5) / 1000.0,
+                       percentile(0.99) / 1000.0, percentile(0.999) / 1000.0, max() / 1000.0);
+}
+
+} // namespace util
+} // namespace mahi
@@ -0,0 +1,284 @@
+#include <Mahi/Util/Timing/Profiler.hpp>
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+namespace mahi {
+namespace util {
+
+namespace {
+
+    /// Events recorded by one thread. The thread is the only producer, and
+    /// the collector (holding the Profiler mutex) is the only consumer. This
+    /// is a plain SPSC ring rather than SPSCQueue so it can be heap allocated
+    /// without over-aligned new.
+    struct ThreadBuffer {
+        ThreadBuffer(std::size_t capacity, uint32 tid) :
+            events(capacity), head(0), tail(0), tid(tid), dropped(0), retired(false) {}
+
+        /// Pushes an event, or returns false if the buffer is full (producer)
+        bool try_push(const ProfileEvent& e) {
+            const std::size_t h    = head.load(std::memory_order_relaxed);
+            const std::size_t next = h + 1 == events.size() ? 0 : h + 1;
+            if (next == tail.load(std::memory_order_acquire))
+                return false;
+            events[h] = e;
+            head.store(next, std::memory_order_release);
+            return true;
+        }
+
+        /// Returns the oldest event, or nullptr if empty (consumer)
+        const ProfileEvent* front() const {
+            const std::size_t t = tail.load(std::memory_order_relaxed);
+            return t == head.load(std::memory_order_acquire) ? nullptr : &events[t];
+        }
+
+        /// Removes the oldest event (consumer)
+        void pop() {
+            const std::size_t t = tail.load(std::memory_order_relaxed);
+            tail.store(t + 1 == events.size() ? 0 : t + 1, std::memory_order_release);
+        }
+
+        std::vector<ProfileEvent> events;    ///< ring storage
+        std::atomic<std::size_t>  head;      ///< next slot to write
+        char                      pad[64];   ///< keeps head and tail on separate cache lines
+        std::atomic<std::size_t>  tail;      ///< next slot to read
+        const uint32              tid;       ///< sequential thread id
+        std::atomic<uint64>       dropped;   ///< events dropped while full
+        std::atomic<bool>         retired;   ///< set when the thread exits
+    };
+
+    /// An event kept for the trace
+    struct TraceEvent {
+        uint32 site;   ///< site id
+        uint32 tid;    ///< thread id
+        int64  begin;  ///< entry time [ns]
+        int64  end;    ///< exit time [ns]
+    };
+
+    /// Shared profiler state, guarded by mutex
+    struct ProfilerState {
+        ProfilerState() : capacity(16384), trace_enabled(false), trace_max(0), dropped(0) {}
+        std::mutex                                 mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;       ///< live thread buffers
+        std::vector<std::string>                   thread_names;  ///< names by thread id
+        std::vector<ProfileStats>                  stats;         ///< stats by site id
+        std::vector<TraceEvent>                    trace;         ///< kept events
+        std::size_t                                capacity;      ///< per-thread buffer capacity
+        bool                                       trace_enabled; ///< keep events for the trace
+        std::size_t                                trace_max;     ///< max events kept
+        uint64                                     dropped;       ///< total dropped events
+    };
+
+    ProfilerState& state() {
+        static ProfilerState s;
+        return s;
+    }
+
+    /// Marks the thread's buffer retired when the thread exits
+    struct BufferOwner {
+        BufferOwner() : buffer(nullptr) {}
+        ~BufferOwner() {
+            if (buffer)
+                buffer->retired.store(true, std::memory_order_release);
+        }
+        ThreadBuffer* buffer;
+    };
+
+    thread_local ThreadBuffer* t_buffer = nullptr;
+
+    ThreadBuffer* make_thread_buffer() {
+        static thread_local BufferOwner owner;
+        ProfilerState& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        const uint32 tid = static_cast<uint32>(s.thread_names.size());
+        s.thread_names.push_back(fmt::format("Thread {}", tid));
+        s.buffers.emplace_back(new ThreadBuffer((std::max)(std::size_t(2), s.capacity), tid));
+        owner.buffer = s.buffers.back().get();
+        return owner.buffer;
+    }
+
+    ThreadBuffer* thread_buffer() {
+        if (!t_buffer)
+            t_buffer = make_thread_buffer();
+        return t_buffer;
+    }
+
+    /// Drains all buffers into the stats and trace (mutex must be held)
+    void drain(ProfilerState& s, bool keep) {
+        for (std::size_t i = 0; i < s.buffers.size();) {
+            ThreadBuffer& buffer = *s.buffers[i];
+            // read retired first so no events can arrive after the final drain
+            const bool retired = buffer.retired.load(std::memory_order_acquire);
+            while (const ProfileEvent* e = buffer.front()) {
+                if (keep) {
+                    ProfileStats& st = s.stats[e->site];
+                    const int64 ns = e->end - e->begin;
+                    st.count++;
+                    st.total += nanoseconds(ns);
+                    if (st.count == 1 || ns < st.min.as_nanoseconds())
+                        st.min = nanoseconds(ns);
+                    if (ns > st.max.as_nanoseconds())
+                        st.max = nanoseconds(ns);
+                    st.histogram.record(ns);
+                    if (s.trace_enabled && s.trace.size() < s.trace_max) {
+                        TraceEvent t = {e->site, buffer.tid, e->begin, e->end};
+                        s.trace.push_back(t);
+                    }
+                }
+                buffer.pop();
+            }
+            s.dropped += buffer.dropped.exchange(0, std::memory_order_relaxed);
+            if (retired)
+                s.buffers.erase(s.buffers.begin() + i);
+            else
+                ++i;
+        }
+    }
+
+} // namespace
+
+//==============================================================================
+// PROFILE STATS
+//==============================================================================
+
+Time ProfileStats::mean() const {
+    return count ? total / static_cast<int64>(count) : Time::Zero;
+}
+
+Time ProfileStats::percentile(double p) const {
+    return nanoseconds(histogram.percentile(p));
+}
+
+//==============================================================================
+// PROFILER
+//==============================================================================
+
+std::atomic<bool> Profiler::enabled_(true);
+
+void Profiler::enable(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::set_buffer_capacity(std::size_t events) {
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.capacity = events;
+}
+
+void Profiler::enable_trace(bool enabled, std::size_t max_events) {
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.trace_enabled = enabled;
+    s.trace_max     = max_events;
+    if (enabled)
+        s.trace.reserve((std::min)(max_events, std::size_t(1) << 20));
+}
+
+void Profiler::set_thread_name(const std::string& name) {
+    ThreadBuffer* buffer = thread_buffer();
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.thread_names[buffer->tid] = name;
+}
+
+void Profiler::collect() {
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    drain(s, true);
+}
+
+std::vector<ProfileStats> Profiler::get_stats() {
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    drain(s, true);
+    std::vector<ProfileStats> stats;
+    for (auto& st : s.stats) {
+        if (st.count > 0)
+            stats.push_back(st);
+    }
+    return stats;
+}
+
+uint64 Profiler::get_dropped() {
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.dropped;
+}
+
+std::string Profiler::summary() {
+    auto stats = get_stats();
+    std::sort(stats.begin(), stats.end(), [](const ProfileStats& a, const ProfileStats& b) { return a.total > b.total; });
+    std::string out = fmt::format("{:<32} {:>10} {:>12} {:>10} {:>10} {:>10} {:>10} {:>10}\n",
+                                  "Scope", "Count", "Total [ms]", "Mean [us]", "Min [us]", "P50 [us]", "P99 [us]", "Max [us]");
+    for (auto& st : stats) {
+        out += fmt::format("{:<32} {:>10} {:>12.3f} {:>10.3f} {:>10.3f} {:>10.3f} {:>10.3f} {:>10.3f}\n",
+                           st.name, st.count, st.total.as_nanoseconds() / 1e6, st.mean().as_nanoseconds() / 1e3,
+                           st.min.as_nanoseconds() / 1e3, st.percentile(0.5).as_nanoseconds() / 1e3,
+                           st.percentile(0.99).as_nanoseconds() / 1e3, st.max.as_nanoseconds() / 1e3);
+    }
+    const uint64 dropped = get_dropped();
+    if (dropped > 0)
+        out += fmt::format("({} events dropped, call Profiler::collect() more often or increase the buffer capacity)\n", dropped);
+    return out;
+}
+
+bool Profiler::save_trace(const std::string& filepath) {
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    drain(s, true);
+    nlohmann::json events = nlohmann::json::array();
+    for (std::size_t tid = 0; tid < s.thread_names.size(); ++tid) {
+        events.push_back({{"name", "thread_name"}, {"ph", "M"}, {"pid", 1}, {"tid", tid},
+                          {"args", {{"name", s.thread_names[tid]}}}});
+    }
+    for (auto& e : s.trace) {
+        // trace-event times are in microseconds
+        events.push_back({{"name", s.stats[e.site].name}, {"cat", "mahi"}, {"ph", "X"}, {"pid", 1}, {"tid", e.tid},
+                          {"ts", e.begin / 1000.0}, {"dur", (e.end - e.begin) / 1000.0}});
+    }
+    nlohmann::json trace = {{"traceEvents", events}, {"displayTimeUnit", "ns"}};
+    std::ofstream file(filepath);
+    if (!file.is_open())
+        return false;
+    file << trace.dump();
+    return file.good();
+}
+
+void Profiler::reset() {
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    drain(s, false);
+    for (auto& st : s.stats) {
+        st.count = 0;
+        st.total = st.min = st.max = Time::Zero;
+        st.histogram.reset();
+    }
+    s.trace.clear();
+    s.dropped = 0;
+}
+
+uint32 Profiler::register_site(const char* name, const char* file, int line) {
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    ProfileStats st;
+    st.name  = name;
+    st.file  = file;
+    st.line  = line;
+    st.count = 0;
+    s.stats.push_back(st);
+    return static_cast<uint32>(s.stats.size() - 1);
+}
+
+void Profiler::record(uint32 site, int64 begin, int64 end) {
+    ThreadBuffer* buffer = thread_buffer();
+    ProfileEvent e = {site, begin, end};
+    if (!buffer->try_push(e))
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace util
+} // namespace mahi
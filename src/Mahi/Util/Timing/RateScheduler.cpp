@@ -0,0 +1,283 @@
+#include <Mahi/Util/Timing/RateScheduler.hpp>
+#include <Mahi/Util/Logging/Log.hpp>
+#include <Mahi/Util/System.hpp>
+#include <algorithm>
+#include <limits>
+
+namespace mahi {
+namespace util {
+
+namespace {
+
+    int64 gcd(int64 a, int64 b) {
+        while (b != 0) {
+            int64 t = a % b;
+            a = b;
+            b = t;
+        }
+        return a;
+    }
+
+    /// Shortest base period a thread may wake at [ns]
+    const int64 MIN_BASE_PERIOD = 10000;
+
+    /// Most base ticks a thread may wake per period of its fastest task
+    const int64 MAX_TICKS_PER_PERIOD = 10;
+
+    /// Returns true if a thread may wake at base with its fastest task period.
+    /// Rates which are not close to harmonic (e.g. 1000 and 60 Hz, with a GCD
+    /// of 2 ns) would otherwise make a thread spin on meaningless ticks.
+    bool valid_base(int64 base, int64 fastest) {
+        return base >= MIN_BASE_PERIOD && base * MAX_TICKS_PER_PERIOD >= fastest;
+    }
+
+} // namespace
+
+struct RateScheduler::Task {
+    std::string           name;      ///< task name
+    int64                 period;    ///< task period [ns]
+    int                   priority;  ///< priority among tasks with equal deadlines
+    int                   thread;    ///< worker the task runs on
+    std::function<void()> func;      ///< task function
+    int64                 divisor;   ///< runs every divisor base ticks
+    std::atomic<int64>    runs;      ///< number of runs
+    std::atomic<int64>    overruns;  ///< number of runs completed after the deadline
+    LatencyHistogram      exec_time; ///< execution times
+};
+
+struct RateScheduler::Worker {
+    Worker() : cpu(-1), base(0), misses(0) {}
+    /// Returns the shortest period of the tasks [ns] (max int64 if none)
+    int64 fastest() const {
+        int64 fastest = (std::numeric_limits<int64>::max)();
+        for (auto t : order)
+            fastest = (std::min)(fastest, t->period);
+        return fastest;
+    }
+    int                cpu;    ///< CPU to pin to, or -1
+    int64              base;   ///< base period [ns] (GCD of task periods)
+    std::vector<Task*> order;  ///< tasks in dispatch order
+    std::thread        thread; ///< the thread
+    std::atomic<int64> misses; ///< base ticks missed
+};
+
+RateScheduler::RateScheduler(std::size_t threads, Timer::WaitMode mode) :
+    mode_(mode),
+    realtime_(false),
+    running_(false)
+{
+    for (std::size_t i = 0; i < (std::max)(threads, std::size_t(1)); ++i)
+        workers_.emplace_back(new Worker());
+}
+
+RateScheduler::~RateScheduler() {
+    stop();
+}
+
+int RateScheduler::add_task(const std::string& name, Frequency f, std::function<void()> task, int priority, int thread) {
+    if (is_running()) {
+        LOG(Error) << "Cannot add task " << name << " while the RateScheduler is running";
+        return -1;
+    }
+    const int64 period = f.to_time().as_nanoseconds();
+    if (f.as_hertz() <= 0 || period <= 0) {
+        LOG(Error) << "Cannot add task " << name << " with frequency " << f;
+        return -1;
+    }
+    if (period < MIN_BASE_PERIOD) {
+        LOG(Error) << "Cannot add task " << name << " with frequency " << f << " (the fastest supported rate is "
+                   << nanoseconds(MIN_BASE_PERIOD).to_frequency() << ")";
+        return -1;
+    }
+    if (thread >= static_cast<int>(workers_.size())) {
+        LOG(Error) << "Cannot add task " << name << " to thread " << thread << " (RateScheduler has " << workers_.size() << " threads)";
+        return -1;
+    }
+    if (thread < 0) {
+        // prefer a thread on which the rates stay harmonic (the fastest task
+        // runs every tick) or an empty thread, then one which merely keeps a
+        // valid base period. Within each, pick the longest base period (fewest
+        // wakeups), then the least loaded thread.
+        int best_tier = 2;
+        int64 best_base = -1;
+        std::size_t best_count = 0;
+        for (std::size_t i = 0; i < workers_.size(); ++i) {
+            const Worker& w = *workers_[i];
+            const int64 fastest = (std::min)(w.fastest(), period);
+            const int64 base = w.base == 0 ? period : gcd(w.base, period);
+            if (!valid_base(base, fastest))
+                continue;
+            const int tier = base == fastest ? 0 : 1;
+            const std::size_t count = w.order.size();
+            if (tier < best_tier || (tier == best_tier && (base > best_base || (base == best_base && count < best_count)))) {
+                best_tier  = tier;
+                best_base  = base;
+                best_count = count;
+                thread     = static_cast<int>(i);
+            }
+        }
+        if (thread < 0) {
+            LOG(Error) << "Cannot add task " << name << " with frequency " << f << " (its rate is not harmonic with the tasks on any thread; add a thread)";
+            return -1;
+        }
+    }
+    else {
+        const Worker& w = *workers_[thread];
+        const int64 base = w.base == 0 ? period : gcd(w.base, period);
+        if (!valid_base(base, (std::min)(w.fastest(), period))) {
+            LOG(Error) << "Cannot add task " << name << " with frequency " << f << " to thread " << thread
+                       << " (its base period would be " << nanoseconds(base) << ")";
+            return -1;
+        }
+    }
+    Worker& worker = *workers_[thread];
+    worker.base = worker.base == 0 ? period : gcd(worker.base, period);
+    tasks_.emplace_back(new Task());
+    Task& t    = *tasks_.back();
+    t.name     = name;
+    t.period   = period;
+    t.priority = priority;
+    t.thread   = thread;
+    t.func     = std::move(task);
+    t.divisor  = 1;
+    t.runs     = 0;
+    t.overruns = 0;
+    worker.order.push_back(&t);
+    return static_cast<int>(tasks_.size() - 1);
+}
+
+void RateScheduler::set_thread_affinity(std::size_t thread, int cpu) {
+    if (thread < workers_.size())
+        workers_[thread]->cpu = cpu;
+}
+
+void RateScheduler::set_realtime(bool realtime) {
+    realtime_ = realtime;
+    realtime_config_ = RealtimeConfig();
+}
+
+void RateScheduler::set_realtime(const RealtimeConfig& config) {
+    realtime_ = true;
+    realtime_config_ = config;
+}
+
+bool RateScheduler::start() {
+    if (is_running() || tasks_.empty())
+        return false;
+    for (auto& w : workers_) {
+        for (auto t : w->order) {
+            t->divisor = t->period / w->base;
+            t->runs = 0;
+            t->overruns = 0;
+            t->exec_time.reset();
+        }
+        // tasks released on the same tick have deadlines ordered by period
+        std::stable_sort(w->order.begin(), w->order.end(), [](const Task* a, const Task* b) {
+            return a->period != b->period ? a->period < b->period : a->priority > b->priority;
+        });
+        w->misses = 0;
+    }
+    running_ = true;
+    for (auto& w : workers_) {
+        if (!w->order.empty())
+            w->thread = std::thread(&RateScheduler::run, this, std::ref(*w));
+    }
+    return true;
+}
+
+void RateScheduler::stop() {
+    running_ = false;
+    for (auto& w : workers_) {
+        if (w->thread.joinable())
+            w->thread.join();
+    }
+}
+
+bool RateScheduler::is_running() const {
+    return running_;
+}
+
+std::size_t RateScheduler::get_task_count() const {
+    return tasks_.size();
+}
+
+Time RateScheduler::get_base_period(std::size_t thread) const {
+    return thread < workers_.size() ? nanoseconds(workers_[thread]->base) : Time::Zero;
+}
+
+RateScheduler::TaskStats RateScheduler::get_task_stats(std::size_t task) const {
+    TaskStats stats;
+    stats.priority = stats.thread = 0;
+    stats.runs = stats.overruns = 0;
+    if (task >= tasks_.size())
+        return stats;
+    const Task& t   = *tasks_[task];
+    stats.name      = t.name;
+    stats.frequency = nanoseconds(t.period).to_frequency();
+    stats.priority  = t.priority;
+    stats.thread    = t.thread;
+    stats.runs      = t.runs;
+    stats.overruns  = t.overruns;
+    stats.exec_time = t.exec_time;
+    return stats;
+}
+
+int64 RateScheduler::get_misses(std::size_t thread) const {
+    return thread < workers_.size() ? workers_[thread]->misses.load() : 0;
+}
+
+void RateScheduler::log_statistics() const {
+    for (std::size_t i = 0; i < workers_.size(); ++i) {
+        if (workers_[i]->order.empty())
+            continue;
+        LOG(Info) << "Thread " << i << ": base period " << nanoseconds(workers_[i]->base) << ", " << workers_[i]->misses << " misses";
+        for (auto t : workers_[i]->order) {
+            LOG(Info) << "  " << t->name << " (" << nanoseconds(t->period).to_frequency() << "): " << t->runs << " runs, "
+                      << t->overruns << " overruns, exec " << t->exec_time.summary();
+        }
+    }
+}
+
+void RateScheduler::run(Worker& worker) {
+    if (realtime_) {
+        RealtimeConfig config = realtime_config_;
+        if (worker.cpu >= 0)
+            config.cpus.assign(1, worker.cpu);
+        RealtimeStatus status = configure_realtime(config);
+        if (!status.ok()) {
+            LOG(Warning) << "RateScheduler thread real-time configuration incomplete: " << status.summary();
+        }
+    }
+    else if (worker.cpu >= 0) {
+        util::set_thread_affinity(worker.cpu);
+    }
+    Timer timer(nanoseconds(worker.base), mode_, false);
+    int64 tick = 0;
+    // scheduled release of the current tick, and the time the thread woke
+    int64 release = Clock::get_current_time().as_nanoseconds();
+    int64 woke = release;
+    while (running_.load(std::memory_order_relaxed)) {
+        for (auto t : worker.order) {
+            if (tick % t->divisor != 0)
+                continue;
+            const int64 begin = Clock::get_current_time().as_nanoseconds();
+            t->func();
+            const int64 end = Clock::get_current_time().as_nanoseconds();
+            t->exec_time.record(end - begin);
+            t->runs.fetch_add(1, std::memory_order_relaxed);
+            if (end > release + t->period)
+                t->overruns.fetch_add(1, std::memory_order_relaxed);
+        }
+        tick++;
+        // a Deadline Timer keeps a fixed schedule, starting over when more
+        // than a tick late; the other modes wait a period from the last wakeup
+        const int64 prev = mode_ != Timer::WaitMode::Deadline || woke - release > worker.base ? woke : release;
+        timer.wait();
+        woke = Clock::get_current_time().as_nanoseconds();
+        release = prev + worker.base;
+        worker.misses.store(timer.get_misses(), std::memory_order_relaxed);
+    }
+}
+
+} // namespace util
+} // namespace mahi
@@ -5,45 +5,74 @@
 namespace mahi {
 namespace util {
 
+namespace {
+
+    const int64 MAX_NS = std::numeric_limits<int64>::max();
+    const int64 MIN_NS = std::numeric_limits<int64>::min();
+
+    /// Converts a (possibly huge) number of nanoseconds to int64, saturating at the limits
+    inline int64 saturate_ns(double ns) {
+        if (ns >= 9.2233720368547758e18)
+            return MAX_NS;
+        if (ns <= -9.2233720368547758e18)
+            return MIN_NS;
+        return static_cast<int64>(ns);
+    }
+
+    /// Scales an integer amount to nanoseconds, saturating at the limits
+    inline int64 saturate_ns(int64 amount, int64 scale) {
+        if (amount > MAX_NS / scale)
+            return MAX_NS;
+        if (amount < MIN_NS / scale)
+            return MIN_NS;
+        return amount * scale;
+    }
+
+} // namespace
+
 //==============================================================================
 // CLASS DEFINITIONS
 //==============================================================================
 
 const Time Time::Zero;
-const Time Time::Inf = microseconds(std::numeric_limits<int64>::max()); // 29k years, effectively infinite :)
+const Time Time::Inf = nanoseconds(std::numeric_limits<int64>::max()); // 292 years, effectively infinite :)
 
 Time::Time() :
-    microseconds_(0)
+    nanoseconds_(0)
 {
 }
 
-Time::Time(int64 microseconds) :
-    microseconds_(microseconds)
+Time::Time(int64 nanoseconds) :
+    nanoseconds_(nanoseconds)
 {
 }
 
 double Time::as_seconds() const
 {
-    return microseconds_ / 1000000.0;
+    return nanoseconds_ / 1000000000.0;
 }
 
 int32 Time::as_milliseconds() const
 {
-    return static_cast<int32>(microseconds_ / 1000);
+    return static_cast<int32>(nanoseconds_ / 1000000);
 }
 
 int64 Time::as_microseconds() const
 {
-    return microseconds_;
+    return nanoseconds_ / 1000;
 }
 
+int64 Time::as_nanoseconds() const
+{
+    return nanoseconds_;
+}
 
 Frequency Time::to_frequency() const {
-    if (microseconds_ == std::numeric_limits<int64>::max())
+    if (nanoseconds_ == std::numeric_limits<int64>::max())
         return Frequency::Zero;
-    if (microseconds_ == 0)
+    if (nanoseconds_ == 0)
         return Frequency::Inf;
-    return megahertz(1.0 / static_cast<double>(microseconds_));
+    return megahertz(1000.0 / static_cast<double>(nanoseconds_));
 }
 
 //==============================================================================
@@ -51,14 +80,18 @@ Frequency Time::to_frequency() const {
 //==============================================================================
 
 Time seconds(double amount) {
-    return Time(static_cast<int64>(amount * 1000000));
+    return Time(saturate_ns(amount * 1000000000.0));
 }
 
 Time milliseconds(int32 amount) {
-    return Time(static_cast<int64>(amount) * 1000);
+    return Time(static_cast<int64>(amount) * 1000000);
 }
 
 Time microseconds(int64 amount) {
+    return Time(saturate_ns(amount, 1000));
+}
+
+Time nanoseconds(int64 amount) {
     return Time(amount);
 }
 
@@ -82,6 +115,10 @@ Time operator ""_us(unsigned long long int ammount) {
     return microseconds(ammount);
 }
 
+Time operator ""_ns(unsigned long long int ammount) {
+    return nanoseconds(ammount);
+}
+
 //==============================================================================
 // OPERATOR OVERLOADS
 //==============================================================================
@@ -91,41 +128,43 @@ std::ostream& operator << (std::ostream& os, const Time& t) {
         os << t.as_seconds() << " s";
     else if (t.as_milliseconds() > 1)
         os << t.as_milliseconds() << " ms";
-    else
+    else if (t.as_microseconds() != 0 || t.as_nanoseconds() == 0)
         os << t.as_microseconds() << " us";
+    else
+        os << t.as_nanoseconds() << " ns";
     return os;
 }
 
 bool operator ==(Time left, Time right) {
-    return left.as_microseconds() == right.as_microseconds();
+    return left.as_nanoseconds() == right.as_nanoseconds();
 }
 
 bool operator !=(Time left, Time right) {
-    return left.as_microseconds() != right.as_microseconds();
+    return left.as_nanoseconds() != right.as_nanoseconds();
 }
 
 bool operator <(Time left, Time right) {
-    return left.as_microseconds() < right.as_microseconds();
+    return left.as_nanoseconds() < right.as_nanoseconds();
 }
 
 bool operator >(Time left, Time right) {
-    return left.as_microseconds() > right.as_microseconds();
+    return left.as_nanoseconds() > right.as_nanoseconds();
 }
 
 bool operator <=(Time left, Time right) {
-    return left.as_microseconds() <= right.as_microseconds();
+    return left.as_nanoseconds() <= right.as_nanoseconds();
 }
 
 bool operator >=(Time left, Time right) {
-    return left.as_microseconds() >= right.as_microseconds();
+    return left.as_nanoseconds() >= right.as_nanoseconds();
 }
 
 Time operator -(Time right) {
-    return microseconds(-right.as_microseconds());
+    return nanoseconds(-right.as_nanoseconds());
 }
 
 Time operator +(Time left, Time right) {
-    return microseconds(left.as_microseconds() + right.as_microseconds());
+    return nanoseconds(left.as_nanoseconds() + right.as_nanoseconds());
 }
 
 Time& operator +=(Time& left, Time right) {
@@ -133,7 +172,7 @@ Time& operator +=(Time& left, Time right) {
 }
 
 Time operator -(Time left, Time right) {
-    return microseconds(left.as_microseconds() - right.as_microseconds());
+    return nanoseconds(left.as_nanoseconds() - right.as_nanoseconds());
 }
 
 Time& operator -=(Time& left, Time right) {
@@ -141,11 +180,11 @@ Time& operator -=(Time& left, Time right) {
 }
 
 Time operator *(Time left, double right) {
-    return seconds(left.as_seconds() * right);
+    return nanoseconds(saturate_ns(static_cast<double>(left.as_nanoseconds()) * right));
 }
 
 Time operator *(Time left, int64 right) {
-    return microseconds(left.as_microseconds() * right);
+    return nanoseconds(left.as_nanoseconds() * right);
 }
 
 Time operator *(double left, Time right) {
@@ -165,11 +204,11 @@ Time& operator *=(Time& left, int64 right) {
 }
 
 Time operator /(Time left, double right) {
-    return seconds(left.as_seconds() / right);
+    return nanoseconds(saturate_ns(static_cast<double>(left.as_nanoseconds()) / right));
 }
 
 Time operator /(Time left, int64 right) {
-    return microseconds(left.as_microseconds() / right);
+    return nanoseconds(left.as_nanoseconds() / right);
 }
 
 Time& operator /=(Time& left, double right) {
@@ -181,11 +220,11 @@ Time& operator /=(Time& left, int64 right) {
 }
 
 double operator /(Time left, Time right) {
-    return left.as_seconds() / right.as_seconds();
+    return static_cast<double>(left.as_nanoseconds()) / static_cast<double>(right.as_nanoseconds());
 }
 
 Time operator %(Time left, Time right) {
-    return microseconds(left.as_microseconds() % right.as_microseconds());
+    return nanoseconds(left.as_nanoseconds() % right.as_nanoseconds());
 }
 
 Time& operator %=(Time& left, Time right) {
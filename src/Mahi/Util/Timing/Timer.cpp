@@ -1,10 +1,64 @@
 #include <Mahi/Util/Timing/Timer.hpp>
+#include <Mahi/Util/Logging/Csv.hpp>
 #include <Mahi/Util/Logging/Log.hpp>
+#include <algorithm>
+#include <cmath>
 #include <thread>
 
+#ifdef _WIN32
+#include <windows.h>
+#elif __APPLE__
+#include <mach/mach_time.h>
+#include <time.h>
+#else
+#include <errno.h>
+#include <time.h>
+#endif
+
 namespace mahi {
 namespace util {
 
+//==============================================================================
+// DEADLINE WAITING
+//==============================================================================
+
+/// Monotonic time in nanoseconds. On Linux this is CLOCK_MONOTONIC (rather
+/// than the CLOCK_MONOTONIC_RAW of Clock) since it is the clock
+/// clock_nanosleep can sleep on.
+static int64 monotonic_ns() {
+#ifdef _WIN32
+    static LARGE_INTEGER frequency = []() { LARGE_INTEGER f; QueryPerformanceFrequency(&f); return f; }();
+    LARGE_INTEGER time;
+    QueryPerformanceCounter(&time);
+    return static_cast<int64>(static_cast<double>(time.QuadPart) * 1.0e9 / static_cast<double>(frequency.QuadPart));
+#elif __APPLE__
+    static mach_timebase_info_data_t frequency = {0, 0};
+    if (frequency.denom == 0)
+        mach_timebase_info(&frequency);
+    return static_cast<int64>(mach_absolute_time() * frequency.numer / frequency.denom);
+#else
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return static_cast<int64>(time.tv_sec) * 1000000000 + time.tv_nsec;
+#endif
+}
+
+/// Sleeps until the monotonic time deadline (in nanoseconds)
+static void sleep_until_ns(int64 deadline) {
+#if defined(_WIN32) || defined(__APPLE__)
+    int64 remaining = deadline - monotonic_ns();
+    if (remaining > 0)
+        sleep(nanoseconds(remaining));
+#else
+    timespec ti;
+    ti.tv_sec  = static_cast<time_t>(deadline / 1000000000);
+    ti.tv_nsec = static_cast<long>(deadline % 1000000000);
+    // an absolute deadline can simply be retried if interrupted
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ti, NULL) == EINTR) {
+    }
+#endif
+}
+
 static void wait_busy(const Time& duration) {
     Clock temp_clock;
     while (temp_clock.get_elapsed_time() < duration) {
@@ -30,13 +84,60 @@ Timer::Timer(Time period, WaitMode mode, bool emit_warnings) :
     prev_time_(Clock::get_current_time()),
     rate_(0.01),
     hybrid_perc_(0.9),
-    warnings_(emit_warnings)
+    warnings_(emit_warnings),
+    deadline_ns_(monotonic_ns()),
+    spin_ns_(100000),
+    latency_mean_(0),
+    latency_dev_(0)
 {
 }
 
 Timer::~Timer() { }
 
+Timer::Timer(const Timer& other) :
+    mode_(other.mode_),
+    clock_(other.clock_),
+    period_(other.period_),
+    ticks_(other.ticks_),
+    misses_(other.misses_),
+    prev_time_(other.prev_time_),
+    waited_(other.waited_),
+    rate_(other.rate_),
+    hybrid_perc_(other.hybrid_perc_),
+    warnings_(other.warnings_),
+    deadline_ns_(other.deadline_ns_),
+    spin_ns_(other.spin_ns_),
+    latency_mean_(other.latency_mean_),
+    latency_dev_(other.latency_dev_),
+    stats_(other.stats_ ? new Statistics(*other.stats_) : nullptr)
+{
+}
+
+Timer& Timer::operator=(const Timer& other) {
+    if (this != &other) {
+        Timer copy(other);
+        std::swap(mode_, copy.mode_);
+        std::swap(clock_, copy.clock_);
+        std::swap(period_, copy.period_);
+        std::swap(ticks_, copy.ticks_);
+        std::swap(misses_, copy.misses_);
+        std::swap(prev_time_, copy.prev_time_);
+        std::swap(waited_, copy.waited_);
+        std::swap(rate_, copy.rate_);
+        std::swap(hybrid_perc_, copy.hybrid_perc_);
+        std::swap(warnings_, copy.warnings_);
+        std::swap(deadline_ns_, copy.deadline_ns_);
+        std::swap(spin_ns_, copy.spin_ns_);
+        std::swap(latency_mean_, copy.latency_mean_);
+        std::swap(latency_dev_, copy.latency_dev_);
+        std::swap(stats_, copy.stats_);
+    }
+    return *this;
+}
+
 void Timer::set_wait_mode(WaitMode mode) {
+    if (mode == WaitMode::Deadline && mode_ != WaitMode::Deadline)
+        deadline_ns_ = monotonic_ns() - (Clock::get_current_time() - prev_time_).as_nanoseconds();
     mode_ = mode;
 }
 
@@ -45,10 +146,26 @@ Time Timer::restart() {
     misses_ = 0;
     prev_time_ = Clock::get_current_time();
     waited_ = Time::Zero;
+    deadline_ns_ = monotonic_ns();
+    reset_statistics();
     return clock_.restart();
 }
 
 Time Timer::wait() {
+    if (!stats_)
+        return mode_ == WaitMode::Deadline ? wait_deadline() : wait_relative();
+    const int64 start  = monotonic_ns();
+    const int64 period = period_.as_nanoseconds();
+    const int64 target = mode_ == WaitMode::Deadline ? deadline_ns_ + period : stats_->last_return_ns + period;
+    Time elapsed = mode_ == WaitMode::Deadline ? wait_deadline() : wait_relative();
+    const int64 end = monotonic_ns();
+    stats_->compute_time.record(start - stats_->last_return_ns);
+    stats_->lateness.record(end - target);
+    stats_->last_return_ns = end;
+    return elapsed;
+}
+
+Time Timer::wait_relative() {
     Time remaining_time = period_ - (Clock::get_current_time() - prev_time_);
 
     if (remaining_time < Time::Zero) {
@@ -75,6 +192,49 @@ Time Timer::wait() {
     return get_elapsed_time();
 }
 
+Time Timer::wait_deadline() {
+    const int64 period = period_.as_nanoseconds();
+    deadline_ns_ += period;
+    int64 now = monotonic_ns();
+    if (now >= deadline_ns_) {
+        misses_++;
+        double miss_rate = get_miss_rate();
+        if (miss_rate >= rate_ && ticks_ > 1000 && warnings_) {
+            LOG(Warning) << "Timer miss rate of " << miss_rate << " exceeded acceptable rate of " << rate_;
+        }
+        // more than a period late: start a new schedule rather than bursting to catch up
+        if (now - deadline_ns_ > period)
+            deadline_ns_ = now;
+    }
+    else {
+        waited_ += nanoseconds(deadline_ns_ - now);
+        const int64 wake = deadline_ns_ - spin_ns_;
+        if (wake > now) {
+            sleep_until_ns(wake);
+            now = monotonic_ns();
+            tune_spin_margin(now - wake, period);
+        }
+        while (now < deadline_ns_)
+            now = monotonic_ns();
+    }
+    prev_time_ = Clock::get_current_time();
+    ticks_++;
+    return get_elapsed_time();
+}
+
+void Timer::tune_spin_margin(int64 latency, int64 period) {
+    // running estimates of the wakeup latency and its deviation
+    const double l = static_cast<double>(latency);
+    latency_mean_ += (l - latency_mean_) / 16.0;
+    latency_dev_  += (std::fabs(l - latency_mean_) - latency_dev_) / 16.0;
+    const int64 target = static_cast<int64>(latency_mean_ + 4.0 * latency_dev_) + 2000;
+    if (latency > spin_ns_)
+        spin_ns_ = latency + latency / 4;    // woke past the deadline: widen quickly
+    else
+        spin_ns_ += (target - spin_ns_) / 64; // otherwise narrow slowly
+    spin_ns_ = (std::max)(static_cast<int64>(1000), (std::min)(spin_ns_, period / 2));
+}
+
 Time Timer::get_elapsed_time() const {
     return clock_.get_elapsed_time();
 }
@@ -115,6 +275,69 @@ void Timer::set_hybrid_percentage(double sleep_percent) {
     hybrid_perc_ = sleep_percent;
 }
 
+void Timer::set_spin_margin(Time margin) {
+    spin_ns_ = margin.as_nanoseconds();
+}
+
+Time Timer::get_spin_margin() const {
+    return nanoseconds(spin_ns_);
+}
+
+void Timer::enable_statistics(bool enable) {
+    if (enable && !stats_) {
+        stats_.reset(new Statistics());
+        stats_->last_return_ns = monotonic_ns();
+    }
+    else if (!enable) {
+        stats_.reset();
+    }
+}
+
+bool Timer::is_statistics_enabled() const {
+    return stats_ != nullptr;
+}
+
+void Timer::reset_statistics() {
+    if (stats_) {
+        stats_->lateness.reset();
+        stats_->compute_time.reset();
+        stats_->last_return_ns = monotonic_ns();
+    }
+}
+
+const LatencyHistogram& Timer::get_lateness() const {
+    static const LatencyHistogram empty;
+    return stats_ ? stats_->lateness : empty;
+}
+
+const LatencyHistogram& Timer::get_compute_time() const {
+    static const LatencyHistogram empty;
+    return stats_ ? stats_->compute_time : empty;
+}
+
+void Timer::log_statistics() const {
+    LOG(Info) << "Timer @ " << get_frequency() << ": " << ticks_ << " ticks, " << misses_ << " misses";
+    LOG(Info) << "Timer lateness:     " << get_lateness().summary();
+    LOG(Info) << "Timer compute time: " << get_compute_time().summary();
+}
+
+bool Timer::save_statistics(const std::string& filepath) const {
+    Csv csv(filepath);
+    if (!csv.is_open())
+        return false;
+    csv.set_float_format(Csv::Fixed);
+    csv.set_precision(3);
+    csv.write_row("metric", "count", "min_us", "mean_us", "p50_us", "p99_us", "p99.9_us", "max_us");
+    const LatencyHistogram* histograms[] = {&get_lateness(), &get_compute_time()};
+    const char* names[] = {"lateness", "compute_time"};
+    for (int i = 0; i < 2; ++i) {
+        const LatencyHistogram& h = *histograms[i];
+        csv.write_row(names[i], h.count(), h.min() / 1000.0, h.mean() / 1000.0, h.percentile(0.5) / 1000.0,
+                      h.percentile(0.99) / 1000.0, h.percentile(0.999) / 1000.0, h.max() / 1000.0);
+    }
+    return true;
+}
+
 void Timer::enable_warnings() {
     warnings_ = true;
 }
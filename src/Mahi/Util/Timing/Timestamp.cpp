@@ -1,12 +1,10 @@
 #include <Mahi/Util/Timing/Timestamp.hpp>
-#include <sstream>
-#include <iomanip>
+#include <fmt/format.h>
+#include <cstring>
+#include <ctime>
 
 #ifdef _WIN32
-#include <sys/timeb.h>
-#include <time.h>
-#else
-#include <sys/time.h>
+#include <windows.h>
 #endif
 
 namespace mahi {
@@ -25,12 +23,66 @@ inline void localtime_s(struct tm* t, const time_t* time) {
 #endif
 }
 
-#ifdef _WIN32
-Timestamp::Timestamp() {
-    timeb tb;
-    ftime(&tb);
-    tm t;
-    mahi::util::localtime_s(&t, &tb.time);
+namespace {
+
+    /// Broken-down local time of the last second converted on this thread
+    struct LocalTimeCache {
+        LocalTimeCache() : secs(-1) {}
+        time_t secs;
+        tm t;
+    };
+
+    /// Converts seconds since epoch to local time, calling localtime only
+    /// when the second changes
+    const tm& cached_localtime(time_t secs) {
+        static thread_local LocalTimeCache cache;
+        if (secs != cache.secs) {
+            mahi::util::localtime_s(&cache.t, &secs);
+            cache.secs = secs;
+        }
+        return cache.t;
+    }
+
+    /// Two-digit lookup table ("00" through "99")
+    const char DIGITS[] =
+        "0001020304050607080910111213141516171819"
+        "2021222324252627282930313233343536373839"
+        "4041424344454647484950515253545556575859"
+        "6061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+    inline char* write_2(char* p, int value) {
+        std::memcpy(p, DIGITS + 2 * value, 2);
+        return p + 2;
+    }
+
+    inline char* write_3(char* p, int value) {
+        *p = static_cast<char>('0' + value / 100);
+        return write_2(p + 1, value % 100);
+    }
+
+    inline char* write_year(char* p, int year) {
+        if (year >= 1000 && year <= 9999)
+            return write_2(write_2(p, year / 100), year % 100);
+        fmt::format_int formatted(year);
+        std::memcpy(p, formatted.data(), formatted.size());
+        return p + formatted.size();
+    }
+
+} // namespace
+
+Timestamp::Timestamp() : Timestamp(epoch_microseconds(Realtime)) {}
+
+Timestamp::Timestamp(Source source) : Timestamp(epoch_microseconds(source)) {}
+
+Timestamp::Timestamp(int64 epoch_us) {
+    int64 secs = epoch_us / 1000000;
+    int64 us   = epoch_us % 1000000;
+    if (us < 0) {
+        secs -= 1;
+        us += 1000000;
+    }
+    const tm& t = cached_localtime(static_cast<time_t>(secs));
     year     = t.tm_year + 1900;
     month    = t.tm_mon + 1;
     yday     = t.tm_yday + 1;
@@ -39,66 +91,85 @@ Timestamp::Timestamp() {
     hour     = t.tm_hour;
     min      = t.tm_min;
     sec      = t.tm_sec;
-    millisec = tb.millitm;
+    millisec = static_cast<int>(us / 1000);
+}
+
+#ifdef _WIN32
+int64 Timestamp::epoch_microseconds(Source) {
+    FILETIME ft;
+    GetSystemTimeAsFileTime(&ft);
+    ULARGE_INTEGER t;
+    t.LowPart  = ft.dwLowDateTime;
+    t.HighPart = ft.dwHighDateTime;
+    // FILETIME counts 100 ns intervals since 1601-01-01
+    return static_cast<int64>(t.QuadPart / 10) - 11644473600000000LL;
 }
 #else
-Timestamp::Timestamp() {
-    timeval tv;
-    ::gettimeofday(&tv, NULL);
-    tm t;
-    mahi::util::localtime_s(&t, &tv.tv_sec);
-    year     = t.tm_year + 1900;
-    month    = t.tm_mon + 1;
-    yday     = t.tm_yday + 1;
-    mday     = t.tm_mday;
-    wday     = t.tm_wday + 1;
-    hour     = t.tm_hour;
-    min      = t.tm_min;
-    sec      = t.tm_sec;
-    millisec = static_cast<unsigned short>(tv.tv_usec / 1000);
+int64 Timestamp::epoch_microseconds(Source source) {
+    timespec ts;
+#ifdef CLOCK_REALTIME_COARSE
+    ::clock_gettime(source == RealtimeCoarse ? CLOCK_REALTIME_COARSE : CLOCK_REALTIME, &ts);
+#else
+    (void)source;
+    ::clock_gettime(CLOCK_REALTIME, &ts);
+#endif
+    return static_cast<int64>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
 }
 #endif
 
+char* Timestamp::write_yyyy_mm_dd(char* p) const {
+    p = write_year(p, year);
+    *p++ = '-';
+    p = write_2(p, month);
+    *p++ = '-';
+    return write_2(p, mday);
+}
+
+char* Timestamp::write_hh_mm_ss_mmm(char* p) const {
+    p = write_2(p, hour);
+    *p++ = ':';
+    p = write_2(p, min);
+    *p++ = ':';
+    p = write_2(p, sec);
+    *p++ = '.';
+    return write_3(p, millisec);
+}
+
+char* Timestamp::write_yyyy_mm_dd_hh_mm_ss(char* p) const {
+    p = write_yyyy_mm_dd(p);
+    *p++ = '_';
+    p = write_2(p, hour);
+    *p++ = '.';
+    p = write_2(p, min);
+    *p++ = '.';
+    return write_2(p, sec);
+}
+
+char* Timestamp::write_yyyy_mm_dd_hh_mm_ss_mmm(char* p) const {
+    p = write_yyyy_mm_dd(p);
+    *p++ = ' ';
+    return write_hh_mm_ss_mmm(p);
+}
+
 std::string Timestamp::yyyy_mm_dd() const {
-    std::ostringstream ss;
-    ss << year << "-"
-        << std::setfill('0') << std::setw(2) << month << ("-")
-        << std::setfill('0') << std::setw(2) << mday;
-    return ss.str();
+    char buffer[MaxSize];
+    return std::string(buffer, write_yyyy_mm_dd(buffer));
 }
 
 std::string Timestamp::hh_mm_ss_mmm() const {
-    std::ostringstream ss;
-    ss  << std::setfill('0') << std::setw(2) << hour << (":")
-        << std::setfill('0') << std::setw(2) << min << (":")
-        << std::setfill('0') << std::setw(2) << sec << (".")
-        << std::setfill('0') << std::setw(3) << millisec;
-    return ss.str();
+    char buffer[MaxSize];
+    return std::string(buffer, write_hh_mm_ss_mmm(buffer));
 }
 
 std::string Timestamp::yyyy_mm_dd_hh_mm_ss() const {
-    std::ostringstream ss;
-    ss << year << "-"
-        << std::setfill('0') << std::setw(2) << month << ("-")
-        << std::setfill('0') << std::setw(2) << mday << ("_")
-        << std::setfill('0') << std::setw(2) << hour << (".")
-        << std::setfill('0') << std::setw(2) << min << (".")
-        << std::setfill('0') << std::setw(2) << sec;
-    return ss.str();
+    char buffer[MaxSize];
+    return std::string(buffer, write_yyyy_mm_dd_hh_mm_ss(buffer));
 }
 
 std::string Timestamp::yyyy_mm_dd_hh_mm_ss_mmm() const {
-    std::ostringstream ss;
-    ss << year << "-"
-    << std::setfill('0') << std::setw(2) << month << ("-")
-    << std::setfill('0') << std::setw(2) << mday << (" ")
-    << std::setfill('0') << std::setw(2) << hour << (":")
-    << std::setfill('0') << std::setw(2) << min << (":")
-    << std::setfill('0') << std::setw(2) << sec << (".")
-    << std::setfill('0') << std::setw(3) << millisec;
-    return ss.str();
+    char buffer[MaxSize];
+    return std::string(buffer, write_yyyy_mm_dd_hh_mm_ss_mmm(buffer));
 }
 
 } // namespace util
 } // namespace mahi
-
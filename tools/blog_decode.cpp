@@ -0,0 +1,43 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab - Rice University
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#include <Mahi/Util/Logging/BinaryLog.hpp>
+#include <Mahi/Util/Print.hpp>
+
+using namespace mahi::util;
+
+// Usage:
+// blog_decode <input.blog> [output.txt]
+// Renders a binary log written by BLOG to text using the TxtFormatter. If no
+// output file is given, the text is printed to stdout.
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        print("Usage: blog_decode <input.blog> [output.txt]");
+        return 1;
+    }
+    bool success;
+    if (argc == 3) {
+        success = decode_binary_log<TxtFormatter>(argv[1], argv[2]);
+    }
+    else {
+        success = decode_binary_log(argv[1], [](const LogRecord& record) {
+            std::string str = TxtFormatter::format(record);
+            std::fwrite(str.data(), 1, str.size(), stdout);
+        });
+    }
+    return success ? 0 : 1;
+}